@@ -0,0 +1,25 @@
+#version 330
+
+in vec4 fragColor;
+in vec4 fragWireColor;
+in vec3 fragLocal;
+flat in vec3 fragHalfSize;
+
+// Uniforms
+uniform float outlineEdges;     // 1 = draw edges in this pass (single-pass outline)
+uniform float outlineWidth;     // Edge width in pixels
+
+out vec4 finalColor;
+
+void main() {
+    // Distance to each pair of faces; on a face one of them is ~0 and the
+    // distance to the nearest edge is the middle one
+    vec3 d = fragHalfSize - abs(fragLocal);
+    float edge = d.x + d.y + d.z - min(d.x, min(d.y, d.z)) - max(d.x, max(d.y, d.z));
+    
+    // Measure in pixels so the outline keeps its width at any distance (1px ramp for AA)
+    float pixels = edge / max(fwidth(edge), 1e-6);
+    float coverage = clamp(outlineWidth - pixels, 0.0, 1.0) * fragWireColor.a * outlineEdges;
+    
+    finalColor = vec4(mix(fragColor.rgb, fragWireColor.rgb, coverage), fragColor.a);
+}
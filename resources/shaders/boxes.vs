@@ -0,0 +1,30 @@
+#version 330
+
+// Unit cube vertex (-0.5..0.5), shared by every instance
+in vec3 vertexPosition;
+
+// Per-instance attributes (advance once per box)
+in vec3 instanceCenter;
+in vec3 instanceSize;
+in vec4 instanceColor;
+in vec4 instanceWireColor;  // Alpha 0 = no outline for this box
+
+// Uniforms
+uniform mat4 mvp;
+uniform float wirePass;     // 0 = solid faces, 1 = edges
+
+// Output to fragment shader
+out vec4 fragColor;
+out vec4 fragWireColor;
+out vec3 fragLocal;         // Offset from the box center in world units
+flat out vec3 fragHalfSize;
+
+void main() {
+    // Edges are pushed out slightly so they don't z-fight with the faces
+    vec3 size = instanceSize + vec3(wirePass * 0.01);
+    fragColor = mix(instanceColor, instanceWireColor, wirePass);
+    fragWireColor = instanceWireColor;
+    fragLocal = vertexPosition * size;
+    fragHalfSize = size * 0.5;
+    gl_Position = mvp * vec4(instanceCenter + fragLocal, 1.0);
+}
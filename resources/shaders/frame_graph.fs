@@ -0,0 +1,46 @@
+#version 330
+
+// Frame time graph: one quad, samples read from a ring buffer texture
+
+in vec2 fragTexCoord;
+
+uniform sampler2D texture0;     // R32F ring buffer of frame times (ms), rowWidth texels per row
+uniform int head;               // Slot the next sample will be written to
+uniform int count;              // Valid samples (<= capacity)
+uniform int capacity;
+uniform int rowWidth;
+uniform float columns;          // Graph width in pixels
+uniform float maxMs;            // Frame time at the top of the graph
+
+out vec4 finalColor;
+
+float Sample(int back) {
+    int slot = (head - 1 - back + capacity) % capacity;
+    return texelFetch(texture0, ivec2(slot % rowWidth, slot / rowWidth), 0).r;
+}
+
+void main() {
+    // Newest sample on the right; each pixel column covers a run of samples and shows
+    // the worst of them, so a single hitch stays visible however long the history is
+    float perColumn = float(capacity) / columns;
+    int column = int(columns) - 1 - int(fragTexCoord.x * columns);
+    int first = int(float(column) * perColumn);
+    int last = min(max(first + 1, int(float(column + 1) * perColumn)), count);
+    
+    float worst = 0.0;
+    for (int i = first; i < last; i++) worst = max(worst, Sample(i));
+    
+    float height = clamp(worst / maxMs, 0.0, 1.0);
+    float y = 1.0 - fragTexCoord.y;
+    
+    // Empty space shows the panel background behind the graph
+    if (first >= count || y > height) discard;
+    
+    if (worst > 33.33) {
+        finalColor = vec4(0.9, 0.16, 0.22, 1.0);    // RED, below 30 fps
+    } else if (worst > 16.67) {
+        finalColor = vec4(0.99, 0.98, 0.0, 1.0);    // YELLOW, below 60 fps
+    } else {
+        finalColor = vec4(0.0, 0.89, 0.19, 1.0);    // GREEN
+    }
+}
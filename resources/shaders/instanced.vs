@@ -0,0 +1,20 @@
+#version 330
+
+// Mesh vertex, shared by every instance of the mesh
+in vec3 vertexPosition;
+
+// Per-instance attributes (advance once per object). Fixed above raylib's mesh attribute
+// locations (0-7), since they are set inside the meshes' own vertex arrays.
+layout(location = 8) in mat4 instanceTransform;     // 8-11
+layout(location = 12) in vec4 instanceColor;
+
+// Uniforms
+uniform mat4 mvp;           // View-projection; the model matrix comes from the instance
+
+// Output to fragment shader
+out vec4 fragColor;
+
+void main() {
+    fragColor = instanceColor;
+    gl_Position = mvp * instanceTransform * vec4(vertexPosition, 1.0);
+}
@@ -4,6 +4,7 @@ in vec2 fragTexCoord;
 
 uniform sampler2D texture0;
 uniform vec2 resolution;
+uniform vec2 region;            // UV extent of the scene region
 uniform float time;
 
 out vec4 finalColor;
@@ -13,16 +14,17 @@ vec3 posterize(vec3 color, float levels) {
     return floor(color * levels) / levels;
 }
 
-// Sobel edge detection on luminance
+// Sobel edge detection on luminance, with neighbours kept inside the region
 float sobel(vec2 uv, vec2 texel) {
-    float tl = dot(texture(texture0, uv + vec2(-1, -1) * texel).rgb, vec3(0.299, 0.587, 0.114));
-    float tm = dot(texture(texture0, uv + vec2( 0, -1) * texel).rgb, vec3(0.299, 0.587, 0.114));
-    float tr = dot(texture(texture0, uv + vec2( 1, -1) * texel).rgb, vec3(0.299, 0.587, 0.114));
-    float ml = dot(texture(texture0, uv + vec2(-1,  0) * texel).rgb, vec3(0.299, 0.587, 0.114));
-    float mr = dot(texture(texture0, uv + vec2( 1,  0) * texel).rgb, vec3(0.299, 0.587, 0.114));
-    float bl = dot(texture(texture0, uv + vec2(-1,  1) * texel).rgb, vec3(0.299, 0.587, 0.114));
-    float bm = dot(texture(texture0, uv + vec2( 0,  1) * texel).rgb, vec3(0.299, 0.587, 0.114));
-    float br = dot(texture(texture0, uv + vec2( 1,  1) * texel).rgb, vec3(0.299, 0.587, 0.114));
+    vec2 lo = 0.5 * texel, hi = region - 0.5 * texel;
+    float tl = dot(texture(texture0, clamp(uv + vec2(-1, -1) * texel, lo, hi)).rgb, vec3(0.299, 0.587, 0.114));
+    float tm = dot(texture(texture0, clamp(uv + vec2( 0, -1) * texel, lo, hi)).rgb, vec3(0.299, 0.587, 0.114));
+    float tr = dot(texture(texture0, clamp(uv + vec2( 1, -1) * texel, lo, hi)).rgb, vec3(0.299, 0.587, 0.114));
+    float ml = dot(texture(texture0, clamp(uv + vec2(-1,  0) * texel, lo, hi)).rgb, vec3(0.299, 0.587, 0.114));
+    float mr = dot(texture(texture0, clamp(uv + vec2( 1,  0) * texel, lo, hi)).rgb, vec3(0.299, 0.587, 0.114));
+    float bl = dot(texture(texture0, clamp(uv + vec2(-1,  1) * texel, lo, hi)).rgb, vec3(0.299, 0.587, 0.114));
+    float bm = dot(texture(texture0, clamp(uv + vec2( 0,  1) * texel, lo, hi)).rgb, vec3(0.299, 0.587, 0.114));
+    float br = dot(texture(texture0, clamp(uv + vec2( 1,  1) * texel, lo, hi)).rgb, vec3(0.299, 0.587, 0.114));
     
     float gx = -tl - 2.0*ml - bl + tr + 2.0*mr + br;
     float gy = -tl - 2.0*tm - tr + bl + 2.0*bm + br;
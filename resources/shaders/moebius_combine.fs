@@ -0,0 +1,46 @@
+#version 330
+
+in vec2 fragTexCoord;
+
+uniform sampler2D texture0;     // Scene colour
+uniform sampler2D lumaTexture;  // Prepass luminance
+uniform vec2 lumaResolution;
+uniform vec2 region;            // UV extent of the scene region in both textures
+
+out vec4 finalColor;
+
+// Posterize colors for that comic/Moebius look
+vec3 posterize(vec3 color, float levels) {
+    return floor(color * levels) / levels;
+}
+
+// Sobel edge detection on the prepass luminance: 8 single-channel fetches, no dots.
+// Neighbours stay inside the region; texels beyond it are cleared or stale.
+float sobel(vec2 uv, vec2 texel) {
+    vec2 lo = 0.5 * texel, hi = region - 0.5 * texel;
+    float tl = texture(lumaTexture, clamp(uv + vec2(-1, -1) * texel, lo, hi)).r;
+    float tm = texture(lumaTexture, clamp(uv + vec2( 0, -1) * texel, lo, hi)).r;
+    float tr = texture(lumaTexture, clamp(uv + vec2( 1, -1) * texel, lo, hi)).r;
+    float ml = texture(lumaTexture, clamp(uv + vec2(-1,  0) * texel, lo, hi)).r;
+    float mr = texture(lumaTexture, clamp(uv + vec2( 1,  0) * texel, lo, hi)).r;
+    float bl = texture(lumaTexture, clamp(uv + vec2(-1,  1) * texel, lo, hi)).r;
+    float bm = texture(lumaTexture, clamp(uv + vec2( 0,  1) * texel, lo, hi)).r;
+    float br = texture(lumaTexture, clamp(uv + vec2( 1,  1) * texel, lo, hi)).r;
+    
+    float gx = -tl - 2.0*ml - bl + tr + 2.0*mr + br;
+    float gy = -tl - 2.0*tm - tr + bl + 2.0*bm + br;
+    
+    return sqrt(gx*gx + gy*gy);
+}
+
+void main() {
+    vec2 uv = fragTexCoord;
+    vec3 color = texture(texture0, uv).rgb;
+    
+    vec3 posterized = posterize(color, 8.0);
+    float line = smoothstep(0.1, 0.3, sobel(uv, 1.0 / lumaResolution));
+    
+    // Dark ink outline
+    vec3 inkColor = vec3(0.1, 0.08, 0.06);
+    finalColor = vec4(mix(posterized, inkColor, line), 1.0);
+}
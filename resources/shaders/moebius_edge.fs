@@ -0,0 +1,36 @@
+#version 330
+
+in vec2 fragTexCoord;
+
+uniform sampler2D texture0;     // Half-res luminance
+uniform vec2 resolution;
+uniform vec2 region;            // UV extent of the scene region
+
+out vec4 finalColor;
+
+// Sobel edge detection on the prepass luminance, with neighbours kept inside the region
+float sobel(vec2 uv, vec2 texel) {
+    vec2 lo = 0.5 * texel, hi = region - 0.5 * texel;
+    float tl = texture(texture0, clamp(uv + vec2(-1, -1) * texel, lo, hi)).r;
+    float tm = texture(texture0, clamp(uv + vec2( 0, -1) * texel, lo, hi)).r;
+    float tr = texture(texture0, clamp(uv + vec2( 1, -1) * texel, lo, hi)).r;
+    float ml = texture(texture0, clamp(uv + vec2(-1,  0) * texel, lo, hi)).r;
+    float mr = texture(texture0, clamp(uv + vec2( 1,  0) * texel, lo, hi)).r;
+    float bl = texture(texture0, clamp(uv + vec2(-1,  1) * texel, lo, hi)).r;
+    float bm = texture(texture0, clamp(uv + vec2( 0,  1) * texel, lo, hi)).r;
+    float br = texture(texture0, clamp(uv + vec2( 1,  1) * texel, lo, hi)).r;
+    
+    float gx = -tl - 2.0*ml - bl + tr + 2.0*mr + br;
+    float gy = -tl - 2.0*tm - tr + bl + 2.0*bm + br;
+    
+    return sqrt(gx*gx + gy*gy);
+}
+
+// Half-res edges: luminance in r (guides the upsample) and ink coverage in g
+void main() {
+    vec2 uv = fragTexCoord;
+    float luma = texture(texture0, uv).r;
+    float line = smoothstep(0.1, 0.3, sobel(uv, 1.0 / resolution));
+    
+    finalColor = vec4(luma, line, 0.0, 1.0);
+}
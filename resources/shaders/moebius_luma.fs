@@ -0,0 +1,14 @@
+#version 330
+
+in vec2 fragTexCoord;
+
+uniform sampler2D texture0;
+
+out vec4 finalColor;
+
+// Luminance prepass: one colour fetch and one dot per texel, written to a single-channel
+// target that the edge detection reads instead of recomputing it for every neighbour
+void main() {
+    float luma = dot(texture(texture0, fragTexCoord).rgb, vec3(0.299, 0.587, 0.114));
+    finalColor = vec4(luma, luma, luma, 1.0);
+}
@@ -0,0 +1,46 @@
+#version 330
+
+in vec2 fragTexCoord;
+
+uniform sampler2D texture0;     // Scene colour
+uniform sampler2D edgeTexture;  // Half-res: luminance in r, ink coverage in g
+uniform vec2 edgeResolution;
+uniform vec2 region;            // UV extent of the scene region in both textures
+
+out vec4 finalColor;
+
+// Posterize colors for that comic/Moebius look
+vec3 posterize(vec3 color, float levels) {
+    return floor(color * levels) / levels;
+}
+
+void main() {
+    vec2 uv = fragTexCoord;
+    vec3 color = texture(texture0, uv).rgb;
+    float luma = dot(color, vec3(0.299, 0.587, 0.114));
+    
+    // Edge-aware upsample: bilinear weights over the 4 nearest half-res texels, each scaled
+    // down by how far its luminance is from this pixel's, so ink from a neighbouring
+    // surface doesn't bleed across the outline
+    vec2 p = uv * edgeResolution - 0.5;
+    ivec2 base = ivec2(floor(p));
+    vec2 f = fract(p);
+    // Only texels inside the region hold edges; the rest are cleared to black
+    ivec2 maxTexel = max(ivec2(region * edgeResolution + 0.5) - 1, ivec2(0));
+    
+    float line = 0.0, total = 0.0;
+    for (int y = 0; y < 2; y++) {
+        for (int x = 0; x < 2; x++) {
+            vec2 s = texelFetch(edgeTexture, clamp(base + ivec2(x, y), ivec2(0), maxTexel), 0).rg;
+            float w = (x == 1 ? f.x : 1.0 - f.x) * (y == 1 ? f.y : 1.0 - f.y);
+            w = w * exp(-abs(luma - s.r) * 16.0) + 1e-4;
+            line += s.g * w;
+            total += w;
+        }
+    }
+    line /= total;
+    
+    // Dark ink outline
+    vec3 inkColor = vec3(0.1, 0.08, 0.06);
+    finalColor = vec4(mix(posterize(color, 8.0), inkColor, line), 1.0);
+}
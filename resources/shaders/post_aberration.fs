@@ -0,0 +1,26 @@
+#version 330
+
+in vec2 fragTexCoord;
+
+uniform sampler2D texture0;
+uniform vec2 resolution;        // Region size in pixels
+uniform vec2 region;            // UV extent of the region in texture0
+
+out vec4 finalColor;
+
+// Chromatic aberration: red and blue sampled along the radius, growing towards the edges.
+// Reads neighbouring texels, so it runs as its own pass instead of fusing.
+void main() {
+    vec2 uv = fragTexCoord / region;
+    vec2 dir = (uv - 0.5) * 3.0 / resolution * region;
+    
+    // Stay inside the region; texels beyond it hold stale contents
+    vec2 halfTexel = 0.5 / vec2(textureSize(texture0, 0));
+    vec2 lo = halfTexel, hi = region - halfTexel;
+    
+    float r = texture(texture0, clamp(fragTexCoord + dir, lo, hi)).r;
+    float g = texture(texture0, fragTexCoord).g;
+    float b = texture(texture0, clamp(fragTexCoord - dir, lo, hi)).b;
+    
+    finalColor = vec4(r, g, b, 1.0);
+}
@@ -0,0 +1,7 @@
+// Colour grade: contrast around mid grey, a little extra saturation and a warm tint
+vec3 grade(vec3 color, vec2 uv) {
+    color = (color - 0.5) * 1.1 + 0.5;
+    float luma = dot(color, vec3(0.299, 0.587, 0.114));
+    color = mix(vec3(luma), color, 1.2);
+    return clamp(color * vec3(1.05, 1.0, 0.92), 0.0, 1.0);
+}
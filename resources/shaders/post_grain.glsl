@@ -0,0 +1,7 @@
+// Animated film grain, strongest in the mid tones
+vec3 grain(vec3 color, vec2 uv) {
+    vec2 p = floor(uv * resolution) + fract(time * 7.0) * 100.0;
+    float n = fract(sin(dot(p, vec2(12.9898, 78.233))) * 43758.5453) - 0.5;
+    float luma = dot(color, vec3(0.299, 0.587, 0.114));
+    return color + n * 0.08 * (1.0 - abs(luma * 2.0 - 1.0));
+}
@@ -0,0 +1,5 @@
+// Darken towards the corners
+vec3 vignette(vec3 color, vec2 uv) {
+    vec2 d = uv - 0.5;
+    return color * smoothstep(0.85, 0.35, length(d * vec2(1.0, 0.8)));
+}
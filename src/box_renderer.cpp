@@ -0,0 +1,243 @@
+// box_renderer.cpp - Instanced drawing of collision boxes
+
+#include "box_renderer.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include "gl_lines.h"
+#include <vector>
+
+static_assert(sizeof(BoxInstance) == 32, "BoxInstance must match the instance attribute layout");
+
+const int CUBE_FACE_VERTICES = 36;
+const int CUBE_EDGE_VERTICES = 24;
+
+// Unit cube centered on the origin: 12 triangles (CCW from outside), then 12 edges
+static std::vector<Vector3> BuildUnitCube() {
+    std::vector<Vector3> vertices;
+    vertices.reserve(CUBE_FACE_VERTICES + CUBE_EDGE_VERTICES);
+    
+    for (int axis = 0; axis < 3; axis++) {
+        int u = (axis + 1) % 3, v = (axis + 2) % 3;
+        for (int sign = -1; sign <= 1; sign += 2) {
+            // Corners walk counter-clockwise around +axis; flip them for the -axis face
+            float corners[4][2] = { { -0.5f, -0.5f }, { 0.5f, -0.5f }, { 0.5f, 0.5f }, { -0.5f, 0.5f } };
+            Vector3 quad[4];
+            for (int c = 0; c < 4; c++) {
+                float p[3];
+                p[axis] = 0.5f * (float)sign;
+                p[u] = corners[sign > 0 ? c : 3 - c][0];
+                p[v] = corners[sign > 0 ? c : 3 - c][1];
+                quad[c] = { p[0], p[1], p[2] };
+            }
+            int order[6] = { 0, 1, 2, 0, 2, 3 };
+            for (int i : order) vertices.push_back(quad[i]);
+        }
+    }
+    
+    for (int axis = 0; axis < 3; axis++) {
+        int u = (axis + 1) % 3, v = (axis + 2) % 3;
+        for (int edge = 0; edge < 4; edge++) {
+            for (int end = -1; end <= 1; end += 2) {
+                float p[3];
+                p[axis] = 0.5f * (float)end;
+                p[u] = (edge & 1) ? 0.5f : -0.5f;
+                p[v] = (edge & 2) ? 0.5f : -0.5f;
+                vertices.push_back({ p[0], p[1], p[2] });
+            }
+        }
+    }
+    return vertices;
+}
+
+void BoxRenderer::Load() {
+    shader = LoadShader("resources/shaders/boxes.vs", "resources/shaders/boxes.fs");
+    int positionLoc = shader.locs[SHADER_LOC_VERTEX_POSITION];
+    mvpLoc = GetShaderLocation(shader, "mvp");
+    wirePassLoc = GetShaderLocation(shader, "wirePass");
+    outlineEdgesLoc = GetShaderLocation(shader, "outlineEdges");
+    outlineWidthLoc = GetShaderLocation(shader, "outlineWidth");
+    
+    ready = shader.id != rlGetShaderIdDefault() && positionLoc >= 0 && mvpLoc >= 0;
+    if (!ready) {
+        TraceLog(LOG_WARNING, "BoxRenderer: instancing shader unavailable, using immediate mode");
+        return;
+    }
+    
+    vao = rlLoadVertexArray();
+    if (!rlEnableVertexArray(vao)) {
+        TraceLog(LOG_WARNING, "BoxRenderer: vertex arrays unsupported, using immediate mode");
+        ready = false;
+        return;
+    }
+    
+    std::vector<Vector3> cube = BuildUnitCube();
+    cubeVbo = rlLoadVertexBuffer(cube.data(), (int)(cube.size() * sizeof(Vector3)), false);
+    rlSetVertexAttribute(positionLoc, 3, RL_FLOAT, false, 0, 0);
+    rlEnableVertexAttribute(positionLoc);
+    rlDisableVertexArray();
+    
+    LoadLineDrawProcs();
+    uploadedVersion = 0;
+    TraceLog(LOG_INFO, "BoxRenderer: instanced box rendering ready");
+}
+
+void BoxRenderer::Unload() {
+    if (instanceVbo != 0) rlUnloadVertexBuffer(instanceVbo);
+    if (cubeVbo != 0) rlUnloadVertexBuffer(cubeVbo);
+    if (vao != 0) rlUnloadVertexArray(vao);
+    if (shader.id != 0) UnloadShader(shader);
+    instanceVbo = cubeVbo = vao = 0;
+    instanceCapacity = instanceCount = 0;
+    ready = false;
+}
+
+// Point the instance attributes at the box in leaf-order slot first
+static void PointInstanceAttributes(const int locs[4], int first) {
+    static const struct { int size; int type; bool normalized; int offset; } layout[4] = {
+        { 3, RL_FLOAT, false, 0 },
+        { 3, RL_FLOAT, false, 12 },
+        { 4, RL_UNSIGNED_BYTE, true, 24 },
+        { 4, RL_UNSIGNED_BYTE, true, 28 },
+    };
+    int base = first * (int)sizeof(BoxInstance);
+    for (int i = 0; i < 4; i++) {
+        if (locs[i] < 0) continue;
+        rlSetVertexAttribute(locs[i], layout[i].size, layout[i].type, layout[i].normalized,
+                             (int)sizeof(BoxInstance), base + layout[i].offset);
+    }
+}
+
+// Merge runs separated by small gaps; widen the gap until the run count is bounded
+static void MergeRanges(std::vector<BVHRange>& ranges) {
+    int gap = BOX_RANGE_MERGE_GAP;
+    while (true) {
+        size_t merged = 0;
+        for (size_t i = 1; i < ranges.size(); i++) {
+            BVHRange& last = ranges[merged];
+            if (ranges[i].first - (last.first + last.count) <= gap) {
+                last.count = ranges[i].first + ranges[i].count - last.first;
+            } else {
+                ranges[++merged] = ranges[i];
+            }
+        }
+        if (!ranges.empty()) ranges.resize(merged + 1);
+        if ((int)ranges.size() <= BOX_MAX_DRAW_RANGES) return;
+        gap *= 2;
+    }
+}
+
+void BoxRenderer::Sync(const CollisionWorld& world) {
+    if (!ready || world.version == uploadedVersion) return;
+    
+    // Leaf order, so frustum query ranges index the buffer directly
+    std::vector<BoxInstance> instances;
+    instances.reserve(world.boxes.size());
+    for (int index : world.bvh.primIndices) {
+        const CollisionBox& box = world.boxes[index];
+        Color wire = box.outline ? box.wireColor : Color{ 0, 0, 0, 0 };
+        instances.push_back({ box.position, box.size, box.color, wire });
+    }
+    instanceCount = (int)instances.size();
+    int bytes = instanceCount * (int)sizeof(BoxInstance);
+    
+    rlEnableVertexArray(vao);
+    if (instanceCount > instanceCapacity) {
+        // Grow the buffer and re-point the instance attributes at it
+        if (instanceVbo != 0) rlUnloadVertexBuffer(instanceVbo);
+        instanceVbo = rlLoadVertexBuffer(instances.data(), bytes, true);
+        instanceCapacity = instanceCount;
+        
+        const char* names[4] = { "instanceCenter", "instanceSize", "instanceColor", "instanceWireColor" };
+        for (int i = 0; i < 4; i++) instanceLocs[i] = GetShaderLocationAttrib(shader, names[i]);
+        PointInstanceAttributes(instanceLocs, 0);
+        for (int loc : instanceLocs) {
+            if (loc < 0) continue;
+            rlEnableVertexAttribute(loc);
+            rlSetVertexAttributeDivisor(loc, 1);
+        }
+    } else if (bytes > 0) {
+        rlUpdateVertexBuffer(instanceVbo, instances.data(), bytes, 0);
+    }
+    rlDisableVertexArray();
+    
+    uploadedVersion = world.version;
+}
+
+int BoxRenderer::Draw(const CollisionWorld& world, const Frustum* frustum) {
+    int boxCount = (int)world.bvh.primIndices.size();
+    ranges.clear();
+    if (frustum) {
+        visibleCount = world.bvh.QueryFrustum(*frustum, ranges);
+        MergeRanges(ranges);
+    } else if (boxCount > 0) {
+        visibleCount = boxCount;
+        ranges.push_back({ 0, boxCount });
+    } else {
+        visibleCount = 0;
+    }
+    drawnCount = 0;
+    for (const BVHRange& range : ranges) drawnCount += range.count;
+    
+    if (!ready) {
+        for (const BVHRange& range : ranges) {
+            for (int i = range.first; i < range.first + range.count; i++) {
+                const CollisionBox& box = world.boxes[world.bvh.primIndices[i]];
+                DrawCube(box.position, box.size.x, box.size.y, box.size.z, box.color);
+                if (box.outline) DrawCubeWires(box.position, box.size.x, box.size.y, box.size.z, box.wireColor);
+            }
+        }
+        return drawnCount * 2;
+    }
+    if (instanceCount == 0 || ranges.empty()) return 0;
+    
+    // Same transform raylib uses for DrawMesh with an identity model matrix
+    Matrix mvp = MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection());
+    float wirePass = 0.0f;
+    float outlineEdges = shaderOutlines ? 1.0f : 0.0f;
+    float outlineWidth = BOX_OUTLINE_WIDTH;
+    int drawCalls = 0;
+    
+    rlEnableShader(shader.id);
+    rlSetUniformMatrix(mvpLoc, mvp);
+    rlSetUniform(wirePassLoc, &wirePass, RL_SHADER_UNIFORM_FLOAT, 1);
+    rlSetUniform(outlineEdgesLoc, &outlineEdges, RL_SHADER_UNIFORM_FLOAT, 1);
+    rlSetUniform(outlineWidthLoc, &outlineWidth, RL_SHADER_UNIFORM_FLOAT, 1);
+    rlEnableVertexArray(vao);
+    rlEnableVertexBuffer(instanceVbo);
+    for (const BVHRange& range : ranges) {
+        PointInstanceAttributes(instanceLocs, range.first);
+        rlDrawVertexArrayInstanced(0, CUBE_FACE_VERTICES, range.count);
+        drawCalls++;
+    }
+    
+    // Separate edge pass: only when the shader isn't outlining
+    bool linePass = !shaderOutlines;
+    bool instancedLines = InstancedLineDrawsAvailable();
+    if (linePass && instancedLines) {
+        wirePass = 1.0f;
+        outlineEdges = 0.0f;
+        rlSetUniform(wirePassLoc, &wirePass, RL_SHADER_UNIFORM_FLOAT, 1);
+        rlSetUniform(outlineEdgesLoc, &outlineEdges, RL_SHADER_UNIFORM_FLOAT, 1);
+        for (const BVHRange& range : ranges) {
+            PointInstanceAttributes(instanceLocs, range.first);
+            DrawLinesInstanced(CUBE_FACE_VERTICES, CUBE_EDGE_VERTICES, range.count);
+            drawCalls++;
+        }
+    }
+    
+    rlDisableVertexBuffer();
+    rlDisableVertexArray();
+    rlDisableShader();
+    
+    // No instanced line entry point (very old drivers): fall back to immediate-mode edges
+    if (linePass && !instancedLines) {
+        for (const BVHRange& range : ranges) {
+            for (int i = range.first; i < range.first + range.count; i++) {
+                const CollisionBox& box = world.boxes[world.bvh.primIndices[i]];
+                if (box.outline) DrawCubeWires(box.position, box.size.x, box.size.y, box.size.z, box.wireColor);
+            }
+        }
+        drawCalls++;
+    }
+    return drawCalls;
+}
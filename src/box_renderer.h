@@ -0,0 +1,57 @@
+// box_renderer.h - Instanced drawing of collision boxes
+#pragma once
+
+#include "raylib.h"
+#include "collision.h"
+#include "frustum.h"
+#include <vector>
+
+// Per-box instance data as laid out in the GPU buffer (32 bytes)
+struct BoxInstance {
+    Vector3 center;
+    Vector3 size;
+    Color color;
+    Color wireColor;
+};
+
+// Draws every CollisionBox as an instance of one unit cube, replacing a DrawCube +
+// DrawCubeWires pair per box. By default the fragment shader outlines the edges in the
+// same draw as the faces; the older separate instanced line pass remains selectable.
+// The instance buffer is only re-uploaded when the world is rebuilt.
+// Instances are stored in BVH leaf order, so the boxes inside a view frustum form a few
+// contiguous runs; each run is drawn by pointing the instance attributes at its first box.
+const int BOX_RANGE_MERGE_GAP = 64;     // Culled boxes worth drawing to save a pair of draw calls
+const int BOX_MAX_DRAW_RANGES = 32;     // Larger gaps are merged until at most this many runs remain
+const float BOX_OUTLINE_WIDTH = 1.25f;  // Shader outline width in pixels
+
+struct BoxRenderer {
+    Shader shader = { 0 };
+    unsigned int vao = 0;
+    unsigned int cubeVbo = 0;           // 36 triangle vertices followed by 24 edge vertices
+    unsigned int instanceVbo = 0;
+    int instanceCapacity = 0;           // Boxes the instance buffer can hold
+    int instanceCount = 0;
+    unsigned int uploadedVersion = 0;   // CollisionWorld::version in the instance buffer
+    int mvpLoc = -1;
+    int wirePassLoc = -1;
+    int outlineEdgesLoc = -1;
+    int outlineWidthLoc = -1;
+    bool shaderOutlines = true;         // Edges in the face pass; false draws a separate line pass
+    int instanceLocs[4] = { -1, -1, -1, -1 };  // center, size, color, wireColor attributes
+    bool ready = false;                 // False if the shader failed; Draw falls back to immediate mode
+    
+    std::vector<BVHRange> ranges;       // Runs drawn by the last Draw, reused between frames
+    int visibleCount = 0;               // Boxes that passed the frustum test in the last Draw
+    int drawnCount = 0;                 // Boxes submitted, including culled ones inside merged runs
+    
+    // Load the shader and cube geometry (needs a GL context)
+    void Load();
+    void Unload();
+    
+    // Re-upload instance data if the world changed since the last upload
+    void Sync(const CollisionWorld& world);
+    
+    // Draw boxes touching the frustum (all boxes if null); call between BeginMode3D/EndMode3D.
+    // Returns the draw calls issued.
+    int Draw(const CollisionWorld& world, const Frustum* frustum = nullptr);
+};
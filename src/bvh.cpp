@@ -0,0 +1,389 @@
+// bvh.cpp - Binned SAH bounding volume hierarchy
+
+#include "bvh.h"
+#include "raymath.h"
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+
+static float Axis(const Vector3& v, int axis) {
+    return (axis == 0) ? v.x : (axis == 1) ? v.y : v.z;
+}
+
+static float SurfaceArea(Vector3 min, Vector3 max) {
+    float dx = max.x - min.x, dy = max.y - min.y, dz = max.z - min.z;
+    return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
+
+static void GrowBounds(Vector3& min, Vector3& max, const BoundingBox& b) {
+    min.x = std::min(min.x, b.min.x); min.y = std::min(min.y, b.min.y); min.z = std::min(min.z, b.min.z);
+    max.x = std::max(max.x, b.max.x); max.y = std::max(max.y, b.max.y); max.z = std::max(max.z, b.max.z);
+}
+
+static bool BoxesOverlap(const Vector3& aMin, const Vector3& aMax, const BoundingBox& b) {
+    return aMax.x >= b.min.x && aMin.x <= b.max.x &&
+           aMax.y >= b.min.y && aMin.y <= b.max.y &&
+           aMax.z >= b.min.z && aMin.z <= b.max.z;
+}
+
+// Slab test; returns entry distance or FLT_MAX on miss
+static float RaySlab(Vector3 origin, Vector3 invDir, Vector3 min, Vector3 max, float maxDistance) {
+    float tx1 = (min.x - origin.x) * invDir.x, tx2 = (max.x - origin.x) * invDir.x;
+    float tmin = std::min(tx1, tx2), tmax = std::max(tx1, tx2);
+    float ty1 = (min.y - origin.y) * invDir.y, ty2 = (max.y - origin.y) * invDir.y;
+    tmin = std::max(tmin, std::min(ty1, ty2)); tmax = std::min(tmax, std::max(ty1, ty2));
+    float tz1 = (min.z - origin.z) * invDir.z, tz2 = (max.z - origin.z) * invDir.z;
+    tmin = std::max(tmin, std::min(tz1, tz2)); tmax = std::min(tmax, std::max(tz1, tz2));
+    if (tmax >= tmin && tmax >= 0.0f && tmin < maxDistance) return tmin;
+    return FLT_MAX;
+}
+
+// Build-time state shared by the recursive subdivision
+struct BVHBuilder {
+    std::vector<BVHNode>& nodes;
+    std::vector<int>& indices;
+    const std::vector<BoundingBox>& bounds;
+    std::vector<Vector3> centroids;
+    
+    void UpdateNodeBounds(BVHNode& node) {
+        node.min = { FLT_MAX, FLT_MAX, FLT_MAX };
+        node.max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        for (int i = node.leftFirst; i < node.leftFirst + node.count; i++) {
+            GrowBounds(node.min, node.max, bounds[indices[i]]);
+        }
+    }
+    
+    // Binned SAH over all three axes; returns best cost (FLT_MAX if no valid split)
+    float FindBestSplit(const BVHNode& node, int* bestAxis, float* bestPos) {
+        float bestCost = FLT_MAX;
+        for (int axis = 0; axis < 3; axis++) {
+            // Bin over centroid extent, not node extent
+            float cMin = FLT_MAX, cMax = -FLT_MAX;
+            for (int i = node.leftFirst; i < node.leftFirst + node.count; i++) {
+                float c = Axis(centroids[indices[i]], axis);
+                cMin = std::min(cMin, c);
+                cMax = std::max(cMax, c);
+            }
+            if (cMax - cMin < 1e-6f) continue;
+            
+            Vector3 binMin[BVH_SAH_BINS], binMax[BVH_SAH_BINS];
+            int binCount[BVH_SAH_BINS] = { 0 };
+            for (int b = 0; b < BVH_SAH_BINS; b++) {
+                binMin[b] = { FLT_MAX, FLT_MAX, FLT_MAX };
+                binMax[b] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+            }
+            float scale = BVH_SAH_BINS / (cMax - cMin);
+            for (int i = node.leftFirst; i < node.leftFirst + node.count; i++) {
+                int prim = indices[i];
+                int b = std::min(BVH_SAH_BINS - 1, (int)((Axis(centroids[prim], axis) - cMin) * scale));
+                binCount[b]++;
+                GrowBounds(binMin[b], binMax[b], bounds[prim]);
+            }
+            
+            // Sweep from both sides to get area/count for each of the BINS-1 planes
+            float leftArea[BVH_SAH_BINS - 1], rightArea[BVH_SAH_BINS - 1];
+            int leftCount[BVH_SAH_BINS - 1], rightCount[BVH_SAH_BINS - 1];
+            Vector3 lMin = { FLT_MAX, FLT_MAX, FLT_MAX }, lMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+            Vector3 rMin = lMin, rMax = lMax;
+            int lSum = 0, rSum = 0;
+            for (int b = 0; b < BVH_SAH_BINS - 1; b++) {
+                lSum += binCount[b];
+                leftCount[b] = lSum;
+                if (binCount[b]) GrowBounds(lMin, lMax, { binMin[b], binMax[b] });
+                leftArea[b] = lSum ? SurfaceArea(lMin, lMax) : 0.0f;
+                
+                int rb = BVH_SAH_BINS - 1 - b;
+                rSum += binCount[rb];
+                rightCount[rb - 1] = rSum;
+                if (binCount[rb]) GrowBounds(rMin, rMax, { binMin[rb], binMax[rb] });
+                rightArea[rb - 1] = rSum ? SurfaceArea(rMin, rMax) : 0.0f;
+            }
+            
+            float binWidth = (cMax - cMin) / BVH_SAH_BINS;
+            for (int b = 0; b < BVH_SAH_BINS - 1; b++) {
+                if (leftCount[b] == 0 || rightCount[b] == 0) continue;
+                float cost = leftCount[b] * leftArea[b] + rightCount[b] * rightArea[b];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    *bestAxis = axis;
+                    *bestPos = cMin + binWidth * (b + 1);
+                }
+            }
+        }
+        return bestCost;
+    }
+    
+    // Object median on the widest centroid axis; used once SAH has gone too deep
+    int MedianSplit(int first, int last) {
+        Vector3 cMin = { FLT_MAX, FLT_MAX, FLT_MAX }, cMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        for (int i = first; i < last; i++) {
+            GrowBounds(cMin, cMax, { centroids[indices[i]], centroids[indices[i]] });
+        }
+        Vector3 extent = Vector3Subtract(cMax, cMin);
+        int axis = (extent.x > extent.y && extent.x > extent.z) ? 0 : (extent.y > extent.z) ? 1 : 2;
+        int mid = first + (last - first) / 2;
+        std::nth_element(indices.begin() + first, indices.begin() + mid, indices.begin() + last,
+            [&](int a, int b) { return Axis(centroids[a], axis) < Axis(centroids[b], axis); });
+        return mid;
+    }
+    
+    void Subdivide(int nodeIndex, int depth) {
+        BVHNode node = nodes[nodeIndex];
+        if (node.count <= 1) return;
+        
+        int axis = 0;
+        float splitPos = 0.0f;
+        float splitCost = FindBestSplit(node, &axis, &splitPos);
+        float nodeArea = SurfaceArea(node.min, node.max);
+        float leafCost = node.count * nodeArea;
+        if (splitCost != FLT_MAX) splitCost += BVH_TRAVERSAL_COST * nodeArea;
+        
+        int first = node.leftFirst;
+        int last = first + node.count;
+        int mid;
+        
+        if (depth >= BVH_MAX_SAH_DEPTH) {
+            // Balanced splits from here keep the tree within the traversal stack
+            if (node.count <= BVH_MAX_LEAF_SIZE) return;
+            mid = MedianSplit(first, last);
+        } else if (splitCost == FLT_MAX) {
+            // All centroids coincide: only split if the leaf would be too large
+            if (node.count <= BVH_MAX_LEAF_SIZE) return;
+            mid = first + node.count / 2;
+        } else {
+            if (splitCost >= leafCost && node.count <= BVH_MAX_LEAF_SIZE) return;
+            mid = (int)(std::partition(indices.begin() + first, indices.begin() + last,
+                [&](int prim) { return Axis(centroids[prim], axis) < splitPos; }) - indices.begin());
+            if (mid == first || mid == last) mid = first + node.count / 2;
+        }
+        
+        // Children are allocated as an adjacent pair
+        int leftIndex = (int)nodes.size();
+        BVHNode left = {}, right = {};
+        left.leftFirst = first;
+        left.count = mid - first;
+        right.leftFirst = mid;
+        right.count = last - mid;
+        UpdateNodeBounds(left);
+        UpdateNodeBounds(right);
+        nodes.push_back(left);
+        nodes.push_back(right);
+        
+        nodes[nodeIndex].leftFirst = leftIndex;
+        nodes[nodeIndex].count = 0;
+        
+        Subdivide(leftIndex, depth + 1);
+        Subdivide(leftIndex + 1, depth + 1);
+    }
+};
+
+void ColliderBVH::Build(const std::vector<BoundingBox>& bounds) {
+    nodes.clear();
+    primIndices.resize(bounds.size());
+    primBounds.clear();
+    if (bounds.empty()) return;
+    
+    for (int i = 0; i < (int)bounds.size(); i++) primIndices[i] = i;
+    
+    BVHBuilder builder = { nodes, primIndices, bounds, {} };
+    builder.centroids.resize(bounds.size());
+    for (size_t i = 0; i < bounds.size(); i++) {
+        builder.centroids[i] = Vector3Scale(Vector3Add(bounds[i].min, bounds[i].max), 0.5f);
+    }
+    
+    nodes.reserve(bounds.size() * 2);
+    BVHNode root = {};
+    root.leftFirst = 0;
+    root.count = (int)bounds.size();
+    builder.UpdateNodeBounds(root);
+    nodes.push_back(root);
+    builder.Subdivide(0, 1);
+    nodes.shrink_to_fit();
+    
+    // Copy bounds into leaf order so traversal reads them sequentially
+    primBounds.resize(bounds.size());
+    for (size_t i = 0; i < bounds.size(); i++) {
+        primBounds[i] = bounds[primIndices[i]];
+    }
+    
+    TraceLog(LOG_INFO, "ColliderBVH: %d primitives, %d nodes, depth %d",
+             (int)bounds.size(), (int)nodes.size(), Depth());
+}
+
+int ColliderBVH::Query(BoundingBox area, std::vector<int>& out) const {
+    if (nodes.empty()) return 0;
+    
+    int added = 0;
+    int stack[BVH_STACK_SIZE];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    
+    while (stackSize > 0) {
+        const BVHNode& node = nodes[stack[--stackSize]];
+        if (!BoxesOverlap(node.min, node.max, area)) continue;
+        
+        if (node.count > 0) {
+            for (int i = node.leftFirst; i < node.leftFirst + node.count; i++) {
+                if (BoxesOverlap(area.min, area.max, primBounds[i])) {
+                    out.push_back(primIndices[i]);
+                    added++;
+                }
+            }
+        } else {
+            stack[stackSize++] = node.leftFirst;
+            stack[stackSize++] = node.leftFirst + 1;
+        }
+    }
+    
+    // Keep collider order so resolution matches a linear scan
+    std::sort(out.end() - added, out.end());
+    return added;
+}
+
+// Extend the last range if this run continues it
+static void AppendRange(std::vector<BVHRange>& out, int first, int count) {
+    if (!out.empty() && out.back().first + out.back().count == first) {
+        out.back().count += count;
+    } else {
+        out.push_back({ first, count });
+    }
+}
+
+int ColliderBVH::QueryFrustum(const Frustum& frustum, std::vector<BVHRange>& out) const {
+    if (nodes.empty()) return 0;
+    
+    // Subtrees found fully inside skip all further plane tests. Children are pushed
+    // right-then-left so leaves pop in ascending primitive order and runs merge.
+    int covered = 0;
+    int stack[BVH_STACK_SIZE];
+    bool stackInside[BVH_STACK_SIZE];
+    int stackSize = 0;
+    stack[stackSize] = 0;
+    stackInside[stackSize++] = false;
+    
+    while (stackSize > 0) {
+        stackSize--;
+        const BVHNode& node = nodes[stack[stackSize]];
+        bool inside = stackInside[stackSize];
+        if (!inside) {
+            int side = FrustumClassifyBox(frustum, node.min, node.max);
+            if (side == FRUSTUM_OUTSIDE) continue;
+            inside = (side == FRUSTUM_INSIDE);
+        }
+        
+        if (node.count > 0) {
+            if (inside) {
+                AppendRange(out, node.leftFirst, node.count);
+                covered += node.count;
+                continue;
+            }
+            for (int i = node.leftFirst; i < node.leftFirst + node.count; i++) {
+                if (FrustumContainsBox(frustum, primBounds[i])) {
+                    AppendRange(out, i, 1);
+                    covered++;
+                }
+            }
+        } else {
+            stack[stackSize] = node.leftFirst + 1;
+            stackInside[stackSize++] = inside;
+            stack[stackSize] = node.leftFirst;
+            stackInside[stackSize++] = inside;
+        }
+    }
+    return covered;
+}
+
+BVHHit ColliderBVH::Raycast(Ray ray, float maxDistance) const {
+    BVHHit hit = { -1, maxDistance, { 0, 0, 0 }, { 0, 0, 0 } };
+    if (nodes.empty()) return hit;
+    
+    Vector3 dir = ray.direction;
+    Vector3 invDir = {
+        (dir.x != 0.0f) ? 1.0f / dir.x : FLT_MAX,
+        (dir.y != 0.0f) ? 1.0f / dir.y : FLT_MAX,
+        (dir.z != 0.0f) ? 1.0f / dir.z : FLT_MAX
+    };
+    
+    int hitLeaf = -1;
+    if (RaySlab(ray.position, invDir, nodes[0].min, nodes[0].max, hit.distance) == FLT_MAX) return hit;
+    
+    // Stack entries carry the node's entry distance, so a node is only re-checked
+    // against the current closest hit instead of re-running its slab test
+    int stack[BVH_STACK_SIZE];
+    float stackDistance[BVH_STACK_SIZE];
+    int stackSize = 0;
+    stack[stackSize] = 0;
+    stackDistance[stackSize++] = 0.0f;
+    
+    while (stackSize > 0) {
+        stackSize--;
+        if (stackDistance[stackSize] >= hit.distance) continue;
+        const BVHNode& node = nodes[stack[stackSize]];
+        
+        if (node.count > 0) {
+            for (int i = node.leftFirst; i < node.leftFirst + node.count; i++) {
+                float t = RaySlab(ray.position, invDir, primBounds[i].min, primBounds[i].max, hit.distance);
+                // Boxes containing the origin (t < 0) are not reported
+                if (t != FLT_MAX && t >= 0.0f) {
+                    hit.distance = t;
+                    hitLeaf = i;
+                }
+            }
+        } else {
+            // Visit the nearer child first so the far one is usually culled
+            int near = node.leftFirst, far = node.leftFirst + 1;
+            float tNear = RaySlab(ray.position, invDir, nodes[near].min, nodes[near].max, hit.distance);
+            float tFar = RaySlab(ray.position, invDir, nodes[far].min, nodes[far].max, hit.distance);
+            if (tNear > tFar) { std::swap(near, far); std::swap(tNear, tFar); }
+            if (tFar != FLT_MAX) {
+                stack[stackSize] = far;
+                stackDistance[stackSize++] = tFar;
+            }
+            if (tNear != FLT_MAX) {
+                stack[stackSize] = near;
+                stackDistance[stackSize++] = tNear;
+            }
+        }
+    }
+    
+    if (hitLeaf >= 0) {
+        const BoundingBox& b = primBounds[hitLeaf];
+        hit.index = primIndices[hitLeaf];
+        hit.point = Vector3Add(ray.position, Vector3Scale(dir, hit.distance));
+        
+        // Normal is the face whose slab was entered last
+        // (axes the ray runs parallel to can never be the entry face)
+        float tx = (dir.x != 0.0f) ? ((dir.x > 0 ? b.min.x : b.max.x) - ray.position.x) * invDir.x : -FLT_MAX;
+        float ty = (dir.y != 0.0f) ? ((dir.y > 0 ? b.min.y : b.max.y) - ray.position.y) * invDir.y : -FLT_MAX;
+        float tz = (dir.z != 0.0f) ? ((dir.z > 0 ? b.min.z : b.max.z) - ray.position.z) * invDir.z : -FLT_MAX;
+        if (tx >= ty && tx >= tz) hit.normal = { dir.x > 0 ? -1.0f : 1.0f, 0, 0 };
+        else if (ty >= tz)        hit.normal = { 0, dir.y > 0 ? -1.0f : 1.0f, 0 };
+        else                      hit.normal = { 0, 0, dir.z > 0 ? -1.0f : 1.0f };
+    }
+    return hit;
+}
+
+int ColliderBVH::Depth() const {
+    if (nodes.empty()) return 0;
+    
+    int maxDepth = 0;
+    int stack[BVH_STACK_SIZE * 2];
+    int depthStack[BVH_STACK_SIZE * 2];
+    int stackSize = 0;
+    stack[stackSize] = 0;
+    depthStack[stackSize++] = 1;
+    
+    while (stackSize > 0) {
+        stackSize--;
+        const BVHNode& node = nodes[stack[stackSize]];
+        int depth = depthStack[stackSize];
+        maxDepth = std::max(maxDepth, depth);
+        if (node.count == 0 && stackSize + 2 <= BVH_STACK_SIZE * 2) {
+            stack[stackSize] = node.leftFirst;
+            depthStack[stackSize++] = depth + 1;
+            stack[stackSize] = node.leftFirst + 1;
+            depthStack[stackSize++] = depth + 1;
+        }
+    }
+    return maxDepth;
+}
@@ -0,0 +1,59 @@
+// bvh.h - Bounding volume hierarchy over static axis-aligned boxes
+#pragma once
+
+#include "raylib.h"
+#include "frustum.h"
+#include <vector>
+
+// Flattened BVH node (32 bytes, two per cache line).
+// Interior nodes: children are nodes[leftFirst] and nodes[leftFirst + 1].
+// Leaf nodes (count > 0): primitives primIndices[leftFirst .. leftFirst + count).
+struct BVHNode {
+    Vector3 min;
+    int leftFirst;
+    Vector3 max;
+    int count;
+};
+
+// Run of primitives in leaf order: primIndices[first .. first + count)
+struct BVHRange {
+    int first;
+    int count;
+};
+
+// Closest-hit result of a BVH raycast
+struct BVHHit {
+    int index;              // Primitive index in the original input order, -1 if no hit
+    float distance;
+    Vector3 point;
+    Vector3 normal;
+};
+
+const int BVH_MAX_LEAF_SIZE = 8;    // Leaves never hold more primitives than this
+const int BVH_SAH_BINS = 16;        // Centroid bins evaluated per split
+const float BVH_TRAVERSAL_COST = 1.0f;  // Cost of visiting a node relative to one box test
+const int BVH_STACK_SIZE = 64;      // Traversal stack entries
+const int BVH_MAX_SAH_DEPTH = 40;   // Past this depth splits fall back to object median
+
+// Static BVH built with the surface area heuristic (binned).
+// Primitive bounds are stored in leaf order so a leaf's boxes are contiguous in memory.
+struct ColliderBVH {
+    std::vector<BVHNode> nodes;
+    std::vector<int> primIndices;           // Leaf order -> original index
+    std::vector<BoundingBox> primBounds;    // Bounds in leaf order
+    
+    void Build(const std::vector<BoundingBox>& bounds);
+    
+    // Append original indices of primitives overlapping area. Returns the number appended.
+    int Query(BoundingBox area, std::vector<int>& out) const;
+    
+    // Append leaf-order ranges of primitives whose bounds touch the frustum, in ascending
+    // order with adjacent runs merged. Returns the number of primitives covered.
+    int QueryFrustum(const Frustum& frustum, std::vector<BVHRange>& out) const;
+    
+    // Closest primitive hit along the ray within maxDistance (direction must be normalized)
+    BVHHit Raycast(Ray ray, float maxDistance) const;
+    
+    // Longest root-to-leaf path (for the debug overlay)
+    int Depth() const;
+};
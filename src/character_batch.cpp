@@ -0,0 +1,70 @@
+// character_batch.cpp - Many walking characters stepped together (bots, remote players)
+
+#include "character_batch.h"
+
+void CharacterBatch::Clear() {
+    count = 0;
+    posX.clear(); posY.clear(); posZ.clear();
+    velX.clear(); velY.clear(); velZ.clear();
+    yaw.clear();
+    grounded.clear();
+    contacts.clear();
+    walkX.clear(); walkZ.clear();
+    jump.clear();
+}
+
+int CharacterBatch::Add(Vector3 position, float agentYaw) {
+    posX.push_back(position.x); posY.push_back(position.y); posZ.push_back(position.z);
+    velX.push_back(0.0f); velY.push_back(0.0f); velZ.push_back(0.0f);
+    yaw.push_back(agentYaw);
+    grounded.push_back(0);
+    contacts.emplace_back();
+    walkX.push_back(0.0f); walkZ.push_back(0.0f);
+    jump.push_back(0);
+    return count++;
+}
+
+void CharacterBatch::SetInput(int agent, const PlayerInput& input, float moveSpeed) {
+    yaw[agent] += input.look.x;
+    Vector3 walkVelocity = GetWalkVelocity(yaw[agent], input, moveSpeed);
+    walkX[agent] = walkVelocity.x;
+    walkZ[agent] = walkVelocity.z;
+    jump[agent] = input.jump ? 1 : 0;
+}
+
+long long CharacterBatch::Step(const CollisionWorld& world, float deltaTime, WorkerPool& pool) {
+    workerTested.assign(pool.WorkerCount(), 0);
+    
+    // Contiguous chunks keep each worker on its own cache lines of the SoA arrays
+    int chunks = (count + CHARACTER_BATCH_CHUNK - 1) / CHARACTER_BATCH_CHUNK;
+    pool.ParallelFor(chunks, [&](int chunk, int worker) {
+        int first = chunk * CHARACTER_BATCH_CHUNK;
+        int last = first + CHARACTER_BATCH_CHUNK < count ? first + CHARACTER_BATCH_CHUNK : count;
+        long long tested = 0;
+        
+        for (int i = first; i < last; i++) {
+            Vector3 position = { posX[i], posY[i], posZ[i] };
+            Vector3 velocity = { walkX[i], velY[i], walkZ[i] };
+            bool isGrounded = grounded[i] != 0;
+            
+            tested += StepWalkingBody(&position, &velocity, &isGrounded, radius, height,
+                                      jump[i] != 0, world, deltaTime, &contacts[i]);
+            
+            posX[i] = position.x; posY[i] = position.y; posZ[i] = position.z;
+            velX[i] = velocity.x; velY[i] = velocity.y; velZ[i] = velocity.z;
+            grounded[i] = isGrounded ? 1 : 0;
+            jump[i] = 0;
+        }
+        workerTested[worker] += tested;
+    });
+    
+    long long total = 0;
+    for (long long tested : workerTested) total += tested;
+    return total;
+}
+
+int CharacterBatch::SleepingCount() const {
+    int sleeping = 0;
+    for (const ContactCache& cache : contacts) sleeping += cache.sleeping ? 1 : 0;
+    return sleeping;
+}
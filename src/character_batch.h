@@ -0,0 +1,50 @@
+// character_batch.h - Many walking characters stepped together (bots, remote players)
+#pragma once
+
+#include "raylib.h"
+#include "player.h"
+#include "worker_pool.h"
+#include <vector>
+
+// Agents per ParallelFor job; small enough to balance, large enough to amortize dispatch
+const int CHARACTER_BATCH_CHUNK = 128;
+
+// Structure-of-arrays character state. Every agent follows the same walking rules as
+// the player (StepWalkingBody) against a shared CollisionWorld, but agents are stepped
+// as a batch split across a WorkerPool. Each agent keeps its own ContactCache, so
+// idle agents sleep and slow ones skip the broadphase. Agents don't collide with each other.
+struct CharacterBatch {
+    int count = 0;
+    float radius = 0.3f;            // Shared collision shape
+    float height = 1.8f;
+    
+    // State
+    std::vector<float> posX, posY, posZ;
+    std::vector<float> velX, velY, velZ;
+    std::vector<float> yaw;
+    std::vector<unsigned char> grounded;
+    std::vector<ContactCache> contacts;
+    
+    // Input for the next Step (see SetInput)
+    std::vector<float> walkX, walkZ;        // Desired horizontal velocity
+    std::vector<unsigned char> jump;
+    
+    // Per-worker narrow-phase counts, sized by Step
+    std::vector<long long> workerTested;
+    
+    void Clear();
+    
+    // Add an agent standing at position (eye height, like Player); returns its index
+    int Add(Vector3 position, float yaw);
+    
+    // Turn by input.look.x degrees and latch movement/jump for the next Step
+    void SetInput(int agent, const PlayerInput& input, float moveSpeed);
+    
+    // Advance every agent by one physics tick; returns boxes tested across all agents
+    long long Step(const CollisionWorld& world, float deltaTime, WorkerPool& pool);
+    
+    Vector3 Position(int agent) const { return { posX[agent], posY[agent], posZ[agent] }; }
+    
+    // Agents whose last tick was skipped because they are at rest
+    int SleepingCount() const;
+};
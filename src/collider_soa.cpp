@@ -0,0 +1,180 @@
+// collider_soa.cpp - Structure-of-arrays collider bounds and SIMD test kernels
+
+#include "collider_soa.h"
+#include <cfloat>
+#include <cstddef>
+
+#if defined(COLLIDER_SIMD_AVX)
+    #include <immintrin.h>
+#elif defined(COLLIDER_SIMD_SSE)
+    #include <emmintrin.h>
+#endif
+
+void ColliderSoA::Clear() {
+    minX.clear(); minY.clear(); minZ.clear();
+    maxX.clear(); maxY.clear(); maxZ.clear();
+    count = 0;
+}
+
+void ColliderSoA::Push(BoundingBox bounds) {
+    // Drop any padding from a previous Finish so entries stay contiguous
+    if ((int)minX.size() != count) {
+        minX.resize(count); minY.resize(count); minZ.resize(count);
+        maxX.resize(count); maxY.resize(count); maxZ.resize(count);
+    }
+    minX.push_back(bounds.min.x); minY.push_back(bounds.min.y); minZ.push_back(bounds.min.z);
+    maxX.push_back(bounds.max.x); maxY.push_back(bounds.max.y); maxZ.push_back(bounds.max.z);
+    count++;
+}
+
+void ColliderSoA::Finish() {
+    // Inverted bounds fail every overlap test
+    size_t padded = (size_t)((count + COLLIDER_SIMD_WIDTH - 1) / COLLIDER_SIMD_WIDTH) * COLLIDER_SIMD_WIDTH;
+    minX.resize(padded, FLT_MAX); minY.resize(padded, FLT_MAX); minZ.resize(padded, FLT_MAX);
+    maxX.resize(padded, -FLT_MAX); maxY.resize(padded, -FLT_MAX); maxZ.resize(padded, -FLT_MAX);
+}
+
+void ColliderSoA::Gather(const ColliderSoA& src, const std::vector<int>& indices) {
+    count = (int)indices.size();
+    minX.resize(count); minY.resize(count); minZ.resize(count);
+    maxX.resize(count); maxY.resize(count); maxZ.resize(count);
+    for (int i = 0; i < count; i++) {
+        int s = indices[i];
+        minX[i] = src.minX[s]; minY[i] = src.minY[s]; minZ[i] = src.minZ[s];
+        maxX[i] = src.maxX[s]; maxY[i] = src.maxY[s]; maxZ[i] = src.maxZ[s];
+    }
+    Finish();
+}
+
+#if defined(COLLIDER_SIMD_AVX)
+
+unsigned int OverlapMask(const ColliderSoA& soa, int first, BoundingBox area) {
+    __m256 m = _mm256_and_ps(
+        _mm256_cmp_ps(_mm256_set1_ps(area.max.x), _mm256_loadu_ps(&soa.minX[first]), _CMP_GE_OQ),
+        _mm256_cmp_ps(_mm256_set1_ps(area.min.x), _mm256_loadu_ps(&soa.maxX[first]), _CMP_LE_OQ));
+    m = _mm256_and_ps(m, _mm256_cmp_ps(_mm256_set1_ps(area.max.y), _mm256_loadu_ps(&soa.minY[first]), _CMP_GE_OQ));
+    m = _mm256_and_ps(m, _mm256_cmp_ps(_mm256_set1_ps(area.min.y), _mm256_loadu_ps(&soa.maxY[first]), _CMP_LE_OQ));
+    m = _mm256_and_ps(m, _mm256_cmp_ps(_mm256_set1_ps(area.max.z), _mm256_loadu_ps(&soa.minZ[first]), _CMP_GE_OQ));
+    m = _mm256_and_ps(m, _mm256_cmp_ps(_mm256_set1_ps(area.min.z), _mm256_loadu_ps(&soa.maxZ[first]), _CMP_LE_OQ));
+    return (unsigned int)_mm256_movemask_ps(m);
+}
+
+// Strict XZ overlap of the player's footprint, shared by the player kernels
+static inline __m256 FootprintMask(const ColliderSoA& soa, int first, Vector3 p, float radius) {
+    __m256 m = _mm256_and_ps(
+        _mm256_cmp_ps(_mm256_set1_ps(p.x + radius), _mm256_loadu_ps(&soa.minX[first]), _CMP_GT_OQ),
+        _mm256_cmp_ps(_mm256_set1_ps(p.x - radius), _mm256_loadu_ps(&soa.maxX[first]), _CMP_LT_OQ));
+    m = _mm256_and_ps(m, _mm256_cmp_ps(_mm256_set1_ps(p.z + radius), _mm256_loadu_ps(&soa.minZ[first]), _CMP_GT_OQ));
+    m = _mm256_and_ps(m, _mm256_cmp_ps(_mm256_set1_ps(p.z - radius), _mm256_loadu_ps(&soa.maxZ[first]), _CMP_LT_OQ));
+    return m;
+}
+
+unsigned int HorizontalContactMask(const ColliderSoA& soa, int first, Vector3 playerPos, float radius, float height) {
+    __m256 top = _mm256_loadu_ps(&soa.maxY[first]);
+    __m256 feet = _mm256_set1_ps(playerPos.y - height);
+    __m256 m = FootprintMask(soa, first, playerPos, radius);
+    m = _mm256_and_ps(m, _mm256_cmp_ps(feet, _mm256_sub_ps(top, _mm256_set1_ps(STEP_ON_TOLERANCE)), _CMP_LT_OQ));
+    m = _mm256_and_ps(m, _mm256_cmp_ps(_mm256_set1_ps(playerPos.y), _mm256_loadu_ps(&soa.minY[first]), _CMP_GE_OQ));
+    return (unsigned int)_mm256_movemask_ps(m);
+}
+
+unsigned int GroundSupportMask(const ColliderSoA& soa, int first, Vector3 playerPos, float radius, float height,
+                               float fallDistance) {
+    __m256 top = _mm256_loadu_ps(&soa.maxY[first]);
+    __m256 feet = _mm256_set1_ps(playerPos.y - height);
+    __m256 m = FootprintMask(soa, first, playerPos, radius);
+    m = _mm256_and_ps(m, _mm256_cmp_ps(feet, _mm256_add_ps(top, _mm256_set1_ps(GROUND_SNAP_ABOVE)), _CMP_LE_OQ));
+    m = _mm256_and_ps(m, _mm256_cmp_ps(_mm256_set1_ps(playerPos.y - height + fallDistance),
+                                       _mm256_sub_ps(top, _mm256_set1_ps(GROUND_SNAP_BELOW)), _CMP_GE_OQ));
+    return (unsigned int)_mm256_movemask_ps(m);
+}
+
+#elif defined(COLLIDER_SIMD_SSE)
+
+unsigned int OverlapMask(const ColliderSoA& soa, int first, BoundingBox area) {
+    __m128 m = _mm_and_ps(
+        _mm_cmpge_ps(_mm_set1_ps(area.max.x), _mm_loadu_ps(&soa.minX[first])),
+        _mm_cmple_ps(_mm_set1_ps(area.min.x), _mm_loadu_ps(&soa.maxX[first])));
+    m = _mm_and_ps(m, _mm_cmpge_ps(_mm_set1_ps(area.max.y), _mm_loadu_ps(&soa.minY[first])));
+    m = _mm_and_ps(m, _mm_cmple_ps(_mm_set1_ps(area.min.y), _mm_loadu_ps(&soa.maxY[first])));
+    m = _mm_and_ps(m, _mm_cmpge_ps(_mm_set1_ps(area.max.z), _mm_loadu_ps(&soa.minZ[first])));
+    m = _mm_and_ps(m, _mm_cmple_ps(_mm_set1_ps(area.min.z), _mm_loadu_ps(&soa.maxZ[first])));
+    return (unsigned int)_mm_movemask_ps(m);
+}
+
+// Strict XZ overlap of the player's footprint, shared by the player kernels
+static inline __m128 FootprintMask(const ColliderSoA& soa, int first, Vector3 p, float radius) {
+    __m128 m = _mm_and_ps(
+        _mm_cmpgt_ps(_mm_set1_ps(p.x + radius), _mm_loadu_ps(&soa.minX[first])),
+        _mm_cmplt_ps(_mm_set1_ps(p.x - radius), _mm_loadu_ps(&soa.maxX[first])));
+    m = _mm_and_ps(m, _mm_cmpgt_ps(_mm_set1_ps(p.z + radius), _mm_loadu_ps(&soa.minZ[first])));
+    m = _mm_and_ps(m, _mm_cmplt_ps(_mm_set1_ps(p.z - radius), _mm_loadu_ps(&soa.maxZ[first])));
+    return m;
+}
+
+unsigned int HorizontalContactMask(const ColliderSoA& soa, int first, Vector3 playerPos, float radius, float height) {
+    __m128 top = _mm_loadu_ps(&soa.maxY[first]);
+    __m128 feet = _mm_set1_ps(playerPos.y - height);
+    __m128 m = FootprintMask(soa, first, playerPos, radius);
+    m = _mm_and_ps(m, _mm_cmplt_ps(feet, _mm_sub_ps(top, _mm_set1_ps(STEP_ON_TOLERANCE))));
+    m = _mm_and_ps(m, _mm_cmpge_ps(_mm_set1_ps(playerPos.y), _mm_loadu_ps(&soa.minY[first])));
+    return (unsigned int)_mm_movemask_ps(m);
+}
+
+unsigned int GroundSupportMask(const ColliderSoA& soa, int first, Vector3 playerPos, float radius, float height,
+                               float fallDistance) {
+    __m128 top = _mm_loadu_ps(&soa.maxY[first]);
+    __m128 feet = _mm_set1_ps(playerPos.y - height);
+    __m128 m = FootprintMask(soa, first, playerPos, radius);
+    m = _mm_and_ps(m, _mm_cmple_ps(feet, _mm_add_ps(top, _mm_set1_ps(GROUND_SNAP_ABOVE))));
+    m = _mm_and_ps(m, _mm_cmpge_ps(_mm_set1_ps(playerPos.y - height + fallDistance),
+                                   _mm_sub_ps(top, _mm_set1_ps(GROUND_SNAP_BELOW))));
+    return (unsigned int)_mm_movemask_ps(m);
+}
+
+#else
+
+unsigned int OverlapMask(const ColliderSoA& soa, int first, BoundingBox area) {
+    unsigned int mask = 0;
+    for (int i = 0; i < COLLIDER_SIMD_WIDTH; i++) {
+        int b = first + i;
+        bool hit = area.max.x >= soa.minX[b] && area.min.x <= soa.maxX[b] &&
+                   area.max.y >= soa.minY[b] && area.min.y <= soa.maxY[b] &&
+                   area.max.z >= soa.minZ[b] && area.min.z <= soa.maxZ[b];
+        mask |= (unsigned int)hit << i;
+    }
+    return mask;
+}
+
+static inline bool FootprintOverlaps(const ColliderSoA& soa, int b, Vector3 p, float radius) {
+    return p.x + radius > soa.minX[b] && p.x - radius < soa.maxX[b] &&
+           p.z + radius > soa.minZ[b] && p.z - radius < soa.maxZ[b];
+}
+
+unsigned int HorizontalContactMask(const ColliderSoA& soa, int first, Vector3 playerPos, float radius, float height) {
+    unsigned int mask = 0;
+    float feetY = playerPos.y - height;
+    for (int i = 0; i < COLLIDER_SIMD_WIDTH; i++) {
+        int b = first + i;
+        bool hit = FootprintOverlaps(soa, b, playerPos, radius) &&
+                   feetY < soa.maxY[b] - STEP_ON_TOLERANCE && playerPos.y >= soa.minY[b];
+        mask |= (unsigned int)hit << i;
+    }
+    return mask;
+}
+
+unsigned int GroundSupportMask(const ColliderSoA& soa, int first, Vector3 playerPos, float radius, float height,
+                               float fallDistance) {
+    unsigned int mask = 0;
+    float feetY = playerPos.y - height;
+    for (int i = 0; i < COLLIDER_SIMD_WIDTH; i++) {
+        int b = first + i;
+        bool hit = FootprintOverlaps(soa, b, playerPos, radius) &&
+                   feetY <= soa.maxY[b] + GROUND_SNAP_ABOVE &&
+                   feetY + fallDistance >= soa.maxY[b] - GROUND_SNAP_BELOW;
+        mask |= (unsigned int)hit << i;
+    }
+    return mask;
+}
+
+#endif
@@ -0,0 +1,60 @@
+// collider_soa.h - Structure-of-arrays collider bounds and SIMD test kernels
+#pragma once
+
+#include "raylib.h"
+#include <vector>
+
+// Kernel width follows the instruction set the build targets
+#if defined(__AVX__)
+    #define COLLIDER_SIMD_AVX
+    const int COLLIDER_SIMD_WIDTH = 8;
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define COLLIDER_SIMD_SSE
+    const int COLLIDER_SIMD_WIDTH = 4;
+#else
+    const int COLLIDER_SIMD_WIDTH = 4;  // Scalar fallback, same block layout
+#endif
+
+// Player/box contact tolerances shared by the scalar and SIMD paths
+const float STEP_ON_TOLERANCE = 0.1f;   // Feet this close below a top count as standing on it
+const float GROUND_SNAP_ABOVE = 0.05f;  // Feet may hover this far above a top and still land
+const float GROUND_SNAP_BELOW = 0.5f;   // Feet may sink this far below a top and snap up
+const float CONTACT_SKIN = 0.001f;      // Gap kept from a surface after a swept stop
+const int MAX_SLIDE_ITERATIONS = 3;     // Contact planes handled per move (corners need 2)
+
+// Precomputed box bounds, one array per component.
+// Arrays are padded to a multiple of COLLIDER_SIMD_WIDTH with empty boxes that never pass a test.
+struct ColliderSoA {
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+    int count = 0;
+    
+    void Clear();
+    void Push(BoundingBox bounds);
+    
+    // Pad to the SIMD width; call after the last Push
+    void Finish();
+    
+    // Copy the listed entries of src (in order) into this set
+    void Gather(const ColliderSoA& src, const std::vector<int>& indices);
+    
+    BoundingBox Bounds(int i) const {
+        return { { minX[i], minY[i], minZ[i] }, { maxX[i], maxY[i], maxZ[i] } };
+    }
+    
+    int PaddedCount() const { return (int)minX.size(); }
+};
+
+// Each kernel tests COLLIDER_SIMD_WIDTH boxes starting at first (a multiple of the width)
+// and returns a bit mask: bit i set means box first + i passes.
+
+// Inclusive 3D overlap with area (same rule as CheckCollisionBoxes)
+unsigned int OverlapMask(const ColliderSoA& soa, int first, BoundingBox area);
+
+// Boxes the player's footprint intrudes into from the side (ShouldApplyHorizontalCollision)
+unsigned int HorizontalContactMask(const ColliderSoA& soa, int first, Vector3 playerPos, float radius, float height);
+
+// Boxes whose top is within snapping range of the player's feet ("standing on top").
+// fallDistance widens the range upward to cover tops the feet passed through this tick.
+unsigned int GroundSupportMask(const ColliderSoA& soa, int first, Vector3 playerPos, float radius, float height,
+                               float fallDistance);
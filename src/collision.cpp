@@ -0,0 +1,290 @@
+// collision.cpp - Static collision boxes and broadphase acceleration
+
+#include "collision.h"
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+
+// Get bounding box from collision box
+BoundingBox GetBoxBounds(const CollisionBox& box) {
+    return {
+        { box.position.x - box.size.x/2, box.position.y - box.size.y/2, box.position.z - box.size.z/2 },
+        { box.position.x + box.size.x/2, box.position.y + box.size.y/2, box.position.z + box.size.z/2 }
+    };
+}
+
+// Check collision between player (cylinder approximated as box) and a collision box
+bool CheckPlayerBoxCollision(Vector3 playerPos, float radius, float height, const CollisionBox& box) {
+    BoundingBox playerBox = {
+        { playerPos.x - radius, playerPos.y - height, playerPos.z - radius },
+        { playerPos.x + radius, playerPos.y, playerPos.z + radius }
+    };
+    return CheckCollisionBoxes(playerBox, GetBoxBounds(box));
+}
+
+// Check if player should have horizontal collision with box (not if standing on top)
+bool ShouldApplyHorizontalCollision(Vector3 playerPos, float radius, float height, const CollisionBox& box) {
+    return ShouldApplyHorizontalCollision(playerPos, radius, height, GetBoxBounds(box));
+}
+
+bool ShouldApplyHorizontalCollision(Vector3 playerPos, float radius, float height, const BoundingBox& boxBounds) {
+    // First check if there's any horizontal overlap
+    bool horizontalOverlap = 
+        (playerPos.x + radius > boxBounds.min.x) && (playerPos.x - radius < boxBounds.max.x) &&
+        (playerPos.z + radius > boxBounds.min.z) && (playerPos.z - radius < boxBounds.max.z);
+    
+    if (!horizontalOverlap) return false;
+    
+    // Player's feet position
+    float feetY = playerPos.y - height;
+    
+    // If player's feet are at or above the box top, they're standing on it - no horizontal collision
+    // Use a small tolerance to prevent edge cases
+    if (feetY >= boxBounds.max.y - STEP_ON_TOLERANCE) {
+        return false;
+    }
+    
+    // If player's head is below box bottom, no collision (shouldn't happen but safety check)
+    if (playerPos.y < boxBounds.min.y) {
+        return false;
+    }
+    
+    // Player is at a height where horizontal collision should apply
+    return true;
+}
+
+// Swept footprint vs box on XZ (box expanded by radius, footprint treated as a point)
+bool SweepFootprint(Vector3 playerPos, Vector3 delta, float radius, const BoundingBox& boxBounds,
+                    float* timeOfImpact, Vector3* normal) {
+    float minX = boxBounds.min.x - radius, maxX = boxBounds.max.x + radius;
+    float minZ = boxBounds.min.z - radius, maxZ = boxBounds.max.z + radius;
+    
+    // Entry/exit times per axis; a still axis must already be inside the slab
+    float enterX, exitX, enterZ, exitZ;
+    if (delta.x == 0.0f) {
+        if (playerPos.x <= minX || playerPos.x >= maxX) return false;
+        enterX = -FLT_MAX; exitX = FLT_MAX;
+    } else {
+        float t1 = (minX - playerPos.x) / delta.x, t2 = (maxX - playerPos.x) / delta.x;
+        enterX = fminf(t1, t2); exitX = fmaxf(t1, t2);
+    }
+    if (delta.z == 0.0f) {
+        if (playerPos.z <= minZ || playerPos.z >= maxZ) return false;
+        enterZ = -FLT_MAX; exitZ = FLT_MAX;
+    } else {
+        float t1 = (minZ - playerPos.z) / delta.z, t2 = (maxZ - playerPos.z) / delta.z;
+        enterZ = fminf(t1, t2); exitZ = fmaxf(t1, t2);
+    }
+    
+    float enter = fmaxf(enterX, enterZ);
+    float exit = fminf(exitX, exitZ);
+    if (enter >= exit || enter >= 1.0f || exit <= 0.0f) return false;
+    if (enter < 0.0f) return false;     // Already overlapping at the start
+    
+    *timeOfImpact = enter;
+    if (enterX > enterZ) *normal = { delta.x > 0 ? -1.0f : 1.0f, 0.0f, 0.0f };
+    else                 *normal = { 0.0f, 0.0f, delta.z > 0 ? -1.0f : 1.0f };
+    return true;
+}
+
+// Swept horizontal move with sliding along contact planes
+Vector3 MoveAndSlide(Vector3 playerPos, Vector3 delta, float radius, float height, const ColliderSoA& boxes) {
+    float feetY = playerPos.y - height;
+    
+    for (int iteration = 0; iteration < MAX_SLIDE_ITERATIONS; iteration++) {
+        if (delta.x == 0.0f && delta.z == 0.0f) break;
+        
+        // Earliest blocking contact along the remaining move
+        float firstHit = 1.0f;
+        Vector3 hitNormal = { 0.0f, 0.0f, 0.0f };
+        for (int i = 0; i < boxes.count; i++) {
+            // Boxes we stand on or pass under don't block sideways movement
+            if (feetY >= boxes.maxY[i] - STEP_ON_TOLERANCE || playerPos.y < boxes.minY[i]) continue;
+            
+            float t;
+            Vector3 n;
+            if (SweepFootprint(playerPos, delta, radius, boxes.Bounds(i), &t, &n) && t < firstHit) {
+                firstHit = t;
+                hitNormal = n;
+            }
+        }
+        
+        if (firstHit >= 1.0f) {
+            playerPos.x += delta.x;
+            playerPos.z += delta.z;
+            break;
+        }
+        
+        // Advance to the contact, keep a small gap, then slide the rest along the plane
+        playerPos.x += delta.x * firstHit + hitNormal.x * CONTACT_SKIN;
+        playerPos.z += delta.z * firstHit + hitNormal.z * CONTACT_SKIN;
+        
+        float remaining = 1.0f - firstHit;
+        delta.x *= remaining;
+        delta.z *= remaining;
+        float into = delta.x * hitNormal.x + delta.z * hitNormal.z;
+        delta.x -= hitNormal.x * into;
+        delta.z -= hitNormal.z * into;
+    }
+    
+    return playerPos;
+}
+
+// Resolve collision by pushing player out of box
+Vector3 ResolveCollision(Vector3 playerPos, float radius, float height, const CollisionBox& box) {
+    return ResolveCollision(playerPos, radius, height, GetBoxBounds(box));
+}
+
+Vector3 ResolveCollision(Vector3 playerPos, float radius, float height, const BoundingBox& boxBounds) {
+    // Calculate overlap on each axis
+    float overlapX1 = (playerPos.x + radius) - boxBounds.min.x;
+    float overlapX2 = boxBounds.max.x - (playerPos.x - radius);
+    float overlapZ1 = (playerPos.z + radius) - boxBounds.min.z;
+    float overlapZ2 = boxBounds.max.z - (playerPos.z - radius);
+    
+    // Find minimum overlap
+    float minOverlapX = (overlapX1 < overlapX2) ? -overlapX1 : overlapX2;
+    float minOverlapZ = (overlapZ1 < overlapZ2) ? -overlapZ1 : overlapZ2;
+    
+    // Push out on axis with smallest overlap
+    if (fabsf(minOverlapX) < fabsf(minOverlapZ)) {
+        playerPos.x += minOverlapX;
+    } else {
+        playerPos.z += minOverlapZ;
+    }
+    
+    return playerPos;
+}
+
+// Build the grid from the collider list
+void CollisionGrid::Build(const std::vector<CollisionBox>& boxes, float desiredCellSize) {
+    boxCount = (int)boxes.size();
+    cellStart.clear();
+    cellItems.clear();
+    cellsX = cellsZ = 0;
+    
+    if (boxes.empty()) return;
+    
+    // World extents of all boxes on XZ
+    float minX = 1e30f, minZ = 1e30f, maxX = -1e30f, maxZ = -1e30f;
+    for (const auto& box : boxes) {
+        BoundingBox b = GetBoxBounds(box);
+        minX = std::min(minX, b.min.x); maxX = std::max(maxX, b.max.x);
+        minZ = std::min(minZ, b.min.z); maxZ = std::max(maxZ, b.max.z);
+    }
+    
+    // Grow cells if the requested size would need too many of them
+    float extentX = std::max(maxX - minX, 0.001f);
+    float extentZ = std::max(maxZ - minZ, 0.001f);
+    cellSize = std::max(desiredCellSize, 0.01f);
+    float minCellSize = sqrtf((extentX * extentZ) / (float)COLLISION_GRID_MAX_CELLS);
+    if (cellSize < minCellSize) cellSize = minCellSize;
+    
+    originX = minX;
+    originZ = minZ;
+    cellsX = (int)(extentX / cellSize) + 1;
+    cellsZ = (int)(extentZ / cellSize) + 1;
+    
+    auto cellRange = [&](const BoundingBox& b, int& x0, int& z0, int& x1, int& z1) {
+        x0 = std::clamp((int)floorf((b.min.x - originX) / cellSize), 0, cellsX - 1);
+        x1 = std::clamp((int)floorf((b.max.x - originX) / cellSize), 0, cellsX - 1);
+        z0 = std::clamp((int)floorf((b.min.z - originZ) / cellSize), 0, cellsZ - 1);
+        z1 = std::clamp((int)floorf((b.max.z - originZ) / cellSize), 0, cellsZ - 1);
+    };
+    
+    // Pass 1: count items per cell, pass 2: prefix sum, pass 3: fill
+    cellStart.assign((size_t)cellsX * cellsZ + 1, 0);
+    for (const auto& box : boxes) {
+        int x0, z0, x1, z1;
+        cellRange(GetBoxBounds(box), x0, z0, x1, z1);
+        for (int z = z0; z <= z1; z++)
+            for (int x = x0; x <= x1; x++)
+                cellStart[z * cellsX + x + 1]++;
+    }
+    for (size_t c = 1; c < cellStart.size(); c++) {
+        cellStart[c] += cellStart[c - 1];
+    }
+    
+    cellItems.resize(cellStart.back());
+    std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+    for (int i = 0; i < boxCount; i++) {
+        int x0, z0, x1, z1;
+        cellRange(GetBoxBounds(boxes[i]), x0, z0, x1, z1);
+        for (int z = z0; z <= z1; z++)
+            for (int x = x0; x <= x1; x++)
+                cellItems[fill[z * cellsX + x]++] = i;
+    }
+    
+    TraceLog(LOG_INFO, "CollisionGrid: %d boxes, %dx%d cells of %.2f, %d entries",
+             boxCount, cellsX, cellsZ, cellSize, (int)cellItems.size());
+}
+
+// Gather boxes from every cell the query footprint touches
+int CollisionGrid::Query(BoundingBox area, std::vector<int>& out) const {
+    if (cellsX == 0 || cellsZ == 0) return 0;
+    
+    // Reject queries entirely outside the grid
+    float gridMaxX = originX + cellsX * cellSize;
+    float gridMaxZ = originZ + cellsZ * cellSize;
+    if (area.max.x < originX || area.min.x > gridMaxX ||
+        area.max.z < originZ || area.min.z > gridMaxZ) {
+        return 0;
+    }
+    
+    int x0 = std::clamp((int)floorf((area.min.x - originX) / cellSize), 0, cellsX - 1);
+    int x1 = std::clamp((int)floorf((area.max.x - originX) / cellSize), 0, cellsX - 1);
+    int z0 = std::clamp((int)floorf((area.min.z - originZ) / cellSize), 0, cellsZ - 1);
+    int z1 = std::clamp((int)floorf((area.max.z - originZ) / cellSize), 0, cellsZ - 1);
+    
+    size_t start = out.size();
+    for (int z = z0; z <= z1; z++) {
+        for (int x = x0; x <= x1; x++) {
+            int cell = z * cellsX + x;
+            out.insert(out.end(), cellItems.begin() + cellStart[cell], cellItems.begin() + cellStart[cell + 1]);
+        }
+    }
+    
+    // Keep collider order so resolution matches a linear scan; a box spanning
+    // several cells is reported once
+    std::sort(out.begin() + start, out.end());
+    out.erase(std::unique(out.begin() + start, out.end()), out.end());
+    return (int)(out.size() - start);
+}
+
+// Rebuild the bounds arrays and both broadphase structures from the current box list
+void CollisionWorld::Build() {
+    std::vector<BoundingBox> bounds;
+    bounds.reserve(boxes.size());
+    soa.Clear();
+    for (const auto& box : boxes) {
+        bounds.push_back(GetBoxBounds(box));
+        soa.Push(bounds.back());
+    }
+    soa.Finish();
+    
+    grid.Build(boxes);
+    bvh.Build(bounds);
+    version++;
+}
+
+int CollisionWorld::QueryBox(BoundingBox area, std::vector<int>& out) const {
+    if (broadphase == BROADPHASE_GRID) return grid.Query(area, out);
+    if (broadphase == BROADPHASE_BVH) return bvh.Query(area, out);
+    
+    // No broadphase: overlap kernel over every box
+    int added = 0;
+    for (int first = 0; first < soa.PaddedCount(); first += COLLIDER_SIMD_WIDTH) {
+        unsigned int mask = OverlapMask(soa, first, area);
+        for (int lane = 0; mask != 0; lane++, mask >>= 1) {
+            if (mask & 1) {
+                out.push_back(first + lane);
+                added++;
+            }
+        }
+    }
+    return added;
+}
+
+BVHHit CollisionWorld::Raycast(Ray ray, float maxDistance) const {
+    return bvh.Raycast(ray, maxDistance);
+}
@@ -0,0 +1,91 @@
+// collision.h - Static collision boxes and broadphase acceleration
+#pragma once
+
+#include "raylib.h"
+#include "bvh.h"
+#include "collider_soa.h"
+#include <vector>
+
+// Collision box structure
+struct CollisionBox {
+    Vector3 position;       // Center position
+    Vector3 size;           // Full size (width, height, depth)
+    Color color;
+    Color wireColor;
+    bool outline = true;    // Draw wireColor edges (per-material; false = plain faces)
+};
+
+// Default broadphase cell size (world units)
+const float COLLISION_GRID_CELL_SIZE = 4.0f;
+// Upper bound on grid cells so huge sparse maps don't explode memory
+const int COLLISION_GRID_MAX_CELLS = 1 << 20;
+
+// Uniform grid broadphase over the XZ plane.
+// Boxes are bucketed into every cell their footprint touches (stored CSR-style:
+// cellStart[c]..cellStart[c+1] indexes into cellItems). The grid is static and
+// only rebuilt when the collider list changes.
+struct CollisionGrid {
+    float cellSize = COLLISION_GRID_CELL_SIZE;
+    float originX = 0.0f;
+    float originZ = 0.0f;
+    int cellsX = 0;
+    int cellsZ = 0;
+    int boxCount = 0;
+    std::vector<int> cellStart;
+    std::vector<int> cellItems;
+    
+    void Build(const std::vector<CollisionBox>& boxes, float desiredCellSize = COLLISION_GRID_CELL_SIZE);
+    
+    // Append indices of boxes whose cells overlap the XZ footprint of area.
+    // Returns the number of indices appended. Safe to call from several threads.
+    int Query(BoundingBox area, std::vector<int>& out) const;
+};
+
+// Broadphase selection for CollisionWorld queries
+const int BROADPHASE_GRID = 0;
+const int BROADPHASE_BVH = 1;
+const int BROADPHASE_NONE = 2;      // Brute-force SIMD sweep over every box
+
+// Static level geometry together with its acceleration structures
+struct CollisionWorld {
+    std::vector<CollisionBox> boxes;
+    ColliderSoA soa;                // Precomputed bounds, same order as boxes
+    CollisionGrid grid;
+    ColliderBVH bvh;
+    int broadphase = BROADPHASE_BVH;
+    unsigned int version = 0;       // Bumped by Build so cached contacts can detect changes
+    
+    // Rebuild bounds, grid and BVH; call whenever boxes change
+    void Build();
+    
+    // Append candidate box indices for area using the active broadphase.
+    // Returns the number of indices appended.
+    int QueryBox(BoundingBox area, std::vector<int>& out) const;
+    
+    // Closest box hit along ray (always uses the BVH)
+    BVHHit Raycast(Ray ray, float maxDistance) const;
+};
+
+// Get bounding box from collision box
+BoundingBox GetBoxBounds(const CollisionBox& box);
+
+// Check collision between player (cylinder approximated as box) and a collision box
+bool CheckPlayerBoxCollision(Vector3 playerPos, float radius, float height, const CollisionBox& box);
+
+// Check if player should have horizontal collision with box (not if standing on top)
+bool ShouldApplyHorizontalCollision(Vector3 playerPos, float radius, float height, const CollisionBox& box);
+bool ShouldApplyHorizontalCollision(Vector3 playerPos, float radius, float height, const BoundingBox& boxBounds);
+
+// Swept footprint vs box on XZ: earliest time of impact in [0, 1) along delta.
+// Boxes the footprint already overlaps are ignored (depenetrate with ResolveCollision).
+bool SweepFootprint(Vector3 playerPos, Vector3 delta, float radius, const BoundingBox& boxBounds,
+                    float* timeOfImpact, Vector3* normal);
+
+// Move the player horizontally by delta, stopping at the first contact and sliding
+// the remainder along the contact plane. Only boxes that block at the player's
+// height are considered (see ShouldApplyHorizontalCollision).
+Vector3 MoveAndSlide(Vector3 playerPos, Vector3 delta, float radius, float height, const ColliderSoA& boxes);
+
+// Resolve collision by pushing player out of box
+Vector3 ResolveCollision(Vector3 playerPos, float radius, float height, const CollisionBox& box);
+Vector3 ResolveCollision(Vector3 playerPos, float radius, float height, const BoundingBox& boxBounds);
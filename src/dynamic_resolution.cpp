@@ -0,0 +1,55 @@
+// dynamic_resolution.cpp - Render scale driven by measured GPU frame time
+
+#include "dynamic_resolution.h"
+#include "gpu_timer.h"
+#include <cmath>
+
+static const float DYNRES_SMOOTHING = 0.1f;   // Weight of each new measurement
+static const float DYNRES_DEAD_BAND = 0.05f;  // Fraction of the budget left alone
+static const float DYNRES_DROP_RATE = 0.75f;  // Fraction of the gap closed per step
+static const float DYNRES_RISE_RATE = 0.25f;
+
+// Updates after a change whose samples may predate it (GPU timer results are read up to
+// GPU_TIMER_FRAMES frames late, and one frame before they're refreshed), then updates whose
+// samples are averaged into the measurement the next step uses
+static const int DYNRES_STALE_FRAMES = GPU_TIMER_FRAMES + 1;
+static const int DYNRES_SAMPLE_FRAMES = 4;
+
+void DynamicResolution::Update(float frameMs) {
+    float previous = scale;
+    
+    // Samples of frames rendered at the old scale would overshoot if applied to the new one:
+    // skip them, then restart the measurement from frames rendered at the current scale
+    if (settling > 0) {
+        settling--;
+        if (settling < DYNRES_SAMPLE_FRAMES && frameMs > 0.0f) {
+            sampleSum += frameMs;
+            samples++;
+        }
+        if (settling == 0 && samples > 0) gpuMs = sampleSum / samples;
+    } else if (frameMs > 0.0f) {
+        gpuMs = gpuMs > 0.0f ? gpuMs + (frameMs - gpuMs) * DYNRES_SMOOTHING : frameMs;
+    }
+    if (minScale > maxScale) minScale = maxScale;
+    if (!enabled || settling > 0 || gpuMs <= 0.0f || budgetMs <= 0.0f) {
+        scale = enabled ? fminf(fmaxf(scale, minScale), maxScale) : 1.0f;
+    } else {
+        float ideal = fminf(fmaxf(scale * sqrtf(budgetMs / gpuMs), minScale), maxScale);
+        if (gpuMs > budgetMs * (1.0f + DYNRES_DEAD_BAND)) {
+            scale += (ideal - scale) * DYNRES_DROP_RATE;
+        } else if (gpuMs < budgetMs * (1.0f - DYNRES_DEAD_BAND)) {
+            scale += (ideal - scale) * DYNRES_RISE_RATE;
+        }
+        scale = fminf(fmaxf(scale, minScale), maxScale);
+    }
+    if (scale != previous) {
+        settling = DYNRES_STALE_FRAMES + DYNRES_SAMPLE_FRAMES;
+        sampleSum = 0.0f;
+        samples = 0;
+    }
+}
+
+int DynamicResolution::Scaled(int size) const {
+    int scaled = (int)(size * scale + 0.5f);
+    return scaled < 1 ? 1 : scaled;
+}
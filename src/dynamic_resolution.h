@@ -0,0 +1,27 @@
+// dynamic_resolution.h - Render scale driven by measured GPU frame time
+#pragma once
+
+// Scales the 3D scene's render resolution so the GPU frame time stays near a budget.
+// Fill cost grows with pixel count, so the scale that fits the budget is about
+// scale * sqrt(budget / measured). The scale drops quickly when over budget and recovers
+// slowly, with a dead band around the budget so it doesn't hunt frame to frame. Samples
+// arrive a few frames late, so after each change the scale holds until they come from
+// frames rendered at it.
+struct DynamicResolution {
+    bool enabled = true;
+    float minScale = 0.5f;          // Bounds for the per-axis scale
+    float maxScale = 1.0f;
+    float budgetMs = 16.0f;         // Target GPU frame time
+    
+    float scale = 1.0f;             // Current per-axis scale
+    float gpuMs = 0.0f;             // Smoothed measurement the scale follows
+    int settling = 0;               // Updates left before the next step after a change
+    float sampleSum = 0.0f;         // Samples at the current scale while settling
+    int samples = 0;
+    
+    // Once per frame with the latest GPU frame time (CPU frame time if unavailable)
+    void Update(float frameMs);
+    
+    // A full-resolution size at the current scale, at least 1
+    int Scaled(int size) const;
+};
@@ -0,0 +1,91 @@
+// frame_graph.cpp - Frame time history kept on the GPU and drawn as a single quad
+
+#include "frame_graph.h"
+#include "rlgl.h"
+#include <algorithm>
+#include <cmath>
+
+void FrameGraph::Load(int sampleCapacity) {
+    Unload();
+    capacity = sampleCapacity;
+    samples.assign(capacity, 0.0f);
+    
+    int rows = (capacity + FRAME_GRAPH_ROW - 1) / FRAME_GRAPH_ROW;
+    std::vector<float> zeros((size_t)FRAME_GRAPH_ROW * rows, 0.0f);
+    history.id = rlLoadTexture(zeros.data(), FRAME_GRAPH_ROW, rows, RL_PIXELFORMAT_UNCOMPRESSED_R32, 1);
+    history.width = FRAME_GRAPH_ROW;
+    history.height = rows;
+    history.mipmaps = 1;
+    history.format = PIXELFORMAT_UNCOMPRESSED_R32;
+    
+    shader = LoadShader(0, "resources/shaders/frame_graph.fs");
+    gpuReady = history.id != 0 && shader.id != 0 && shader.id != rlGetShaderIdDefault();
+    if (!gpuReady) {
+        TraceLog(LOG_WARNING, "FrameGraph: shader or float texture unavailable, reducing on the CPU");
+        return;
+    }
+    headLoc = GetShaderLocation(shader, "head");
+    countLoc = GetShaderLocation(shader, "count");
+    capacityLoc = GetShaderLocation(shader, "capacity");
+    rowWidthLoc = GetShaderLocation(shader, "rowWidth");
+    columnsLoc = GetShaderLocation(shader, "columns");
+    maxMsLoc = GetShaderLocation(shader, "maxMs");
+    
+    int rowWidth = FRAME_GRAPH_ROW;
+    SetShaderValue(shader, capacityLoc, &capacity, SHADER_UNIFORM_INT);
+    SetShaderValue(shader, rowWidthLoc, &rowWidth, SHADER_UNIFORM_INT);
+}
+
+void FrameGraph::Unload() {
+    if (history.id != 0) rlUnloadTexture(history.id);
+    if (shader.id != 0 && shader.id != rlGetShaderIdDefault()) UnloadShader(shader);
+    history = { 0 };
+    shader = { 0 };
+    samples.clear();
+    head = count = capacity = 0;
+    gpuReady = false;
+}
+
+void FrameGraph::Push(float ms) {
+    if (capacity == 0) return;
+    samples[head] = ms;
+    if (gpuReady) {
+        rlUpdateTexture(history.id, head % FRAME_GRAPH_ROW, head / FRAME_GRAPH_ROW, 1, 1,
+                        RL_PIXELFORMAT_UNCOMPRESSED_R32, &ms);
+    }
+    head = (head + 1) % capacity;
+    count = std::min(count + 1, capacity);
+}
+
+int FrameGraph::Draw(Rectangle bounds, float maxMs) const {
+    if (capacity == 0 || count == 0 || bounds.width < 1.0f) return 0;
+    
+    if (gpuReady) {
+        float columns = floorf(bounds.width);
+        SetShaderValue(shader, headLoc, &head, SHADER_UNIFORM_INT);
+        SetShaderValue(shader, countLoc, &count, SHADER_UNIFORM_INT);
+        SetShaderValue(shader, columnsLoc, &columns, SHADER_UNIFORM_FLOAT);
+        SetShaderValue(shader, maxMsLoc, &maxMs, SHADER_UNIFORM_FLOAT);
+        BeginShaderMode(shader);
+        DrawTexturePro(history, (Rectangle){ 0, 0, (float)history.width, (float)history.height },
+                       (Rectangle){ bounds.x, bounds.y, columns, bounds.height }, (Vector2){ 0, 0 }, 0.0f, WHITE);
+        EndShaderMode();
+        return 1;
+    }
+    
+    // Same per-column maximum as the shader, one rectangle per column (batched by rlgl)
+    int columns = (int)bounds.width;
+    float perColumn = (float)capacity / columns;
+    for (int column = 0; column < columns; column++) {
+        int first = (int)(column * perColumn);
+        int last = std::min(std::max(first + 1, (int)((column + 1) * perColumn)), count);
+        float worst = 0.0f;
+        for (int i = first; i < last; i++) worst = std::max(worst, samples[(head - 1 - i + capacity) % capacity]);
+        if (first >= count || worst <= 0.0f) continue;
+        
+        float height = std::min(worst / maxMs, 1.0f) * bounds.height;
+        Color color = worst > 33.33f ? RED : (worst > 16.67f ? YELLOW : GREEN);
+        DrawRectangle((int)bounds.x + columns - 1 - column, (int)(bounds.y + bounds.height - height), 1, (int)height, color);
+    }
+    return 1;
+}
@@ -0,0 +1,32 @@
+// frame_graph.h - Frame time history kept on the GPU and drawn as a single quad
+#pragma once
+
+#include "raylib.h"
+#include <vector>
+
+const int FRAME_GRAPH_ROW = 1024;               // Texels per row of the history texture
+const int FRAME_GRAPH_CAPACITY = 60 * 144;      // One minute at 144 Hz
+const float FRAME_GRAPH_MAX_MS = 33.33f;        // Top of the graph (30 fps)
+
+// Frame times live in a float texture used as a ring buffer: each Push writes one texel,
+// and Draw is one textured quad whose fragment shader reduces the samples under each
+// pixel column to their maximum, so long histories stay cheap and hitches stay visible.
+struct FrameGraph {
+    Texture2D history = { 0 };      // R32 ring buffer, FRAME_GRAPH_ROW texels wide
+    Shader shader = { 0 };
+    int headLoc = -1, countLoc = -1, capacityLoc = -1, rowWidthLoc = -1, columnsLoc = -1, maxMsLoc = -1;
+    std::vector<float> samples;     // CPU copy of the ring, for the fallback path
+    int head = 0;                   // Slot the next sample goes to
+    int count = 0;
+    int capacity = 0;
+    bool gpuReady = false;          // Shader compiled; otherwise Draw reduces on the CPU
+    
+    void Load(int sampleCapacity = FRAME_GRAPH_CAPACITY);
+    void Unload();
+    
+    // Record one frame time (ms)
+    void Push(float ms);
+    
+    // Draw the history into bounds, newest on the right. Returns the draw calls issued.
+    int Draw(Rectangle bounds, float maxMs = FRAME_GRAPH_MAX_MS) const;
+};
@@ -0,0 +1,99 @@
+// frame_pipeline.cpp - Simulation on a worker thread, pipelined one frame ahead of drawing
+
+#include "frame_pipeline.h"
+#include <chrono>
+#include <utility>
+
+static float MillisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void FramePipeline::Start(const std::function<void(int)>& fn) {
+    Stop();
+    simulate = fn;
+    stopping = false;
+    requested = fresh = primed = false;
+    thread = std::thread(&FramePipeline::WorkerLoop, this);
+}
+
+void FramePipeline::Stop() {
+    if (!thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    thread.join();
+}
+
+int FramePipeline::Advance(const std::function<void()>& handOver) {
+    // Serial, or nothing drawable yet: simulate this frame and wait for it. A frame still
+    // in flight from threaded mode is collected first so the worker is idle for handOver.
+    if (!threaded || !thread.joinable() || !primed) {
+        Acquire();
+        handOver();
+        Kick();
+        primed = true;
+        return Acquire();
+    }
+    
+    // Threaded: take the frame simulated while the last one was drawn (or draw the last
+    // one again while the pipeline fills after a switch from serial), then start this
+    // frame's simulation so it runs while the returned slot is drawn
+    int slot = Acquire();
+    handOver();
+    Kick();
+    return slot;
+}
+
+void FramePipeline::Kick() {
+    if (!threaded || !thread.joinable()) {
+        auto start = std::chrono::steady_clock::now();
+        simulate(writeSlot);
+        std::lock_guard<std::mutex> lock(mutex);
+        std::swap(writeSlot, readySlot);
+        fresh = true;
+        finishedMs = MillisecondsSince(start);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        requested = true;
+    }
+    wake.notify_one();
+}
+
+int FramePipeline::Acquire() {
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return fresh || !requested; });
+    
+    // Nothing kicked since the last Acquire: draw the last frame again
+    if (!fresh) return readSlot;
+    
+    std::swap(readSlot, readySlot);
+    fresh = false;
+    simMs = finishedMs;
+    return readSlot;
+}
+
+void FramePipeline::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this] { return requested || stopping; });
+        if (stopping) return;
+        
+        // writeSlot only changes here and in Kick's inline path, never while requested
+        int slot = writeSlot;
+        lock.unlock();
+        auto start = std::chrono::steady_clock::now();
+        simulate(slot);
+        float ms = MillisecondsSince(start);
+        lock.lock();
+        
+        std::swap(writeSlot, readySlot);
+        fresh = true;
+        requested = false;
+        finishedMs = ms;
+        done.notify_all();
+    }
+}
@@ -0,0 +1,54 @@
+// frame_pipeline.h - Simulation on a worker thread, pipelined one frame ahead of drawing
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+const int FRAME_PIPELINE_SLOTS = 3;
+
+// Runs each frame's simulation on a dedicated thread while the main thread submits the
+// previous frame to GL, so a frame costs about max(sim, submit) instead of their sum.
+// Simulations fill one of three frame slots owned by the caller: the worker writes one,
+// the main thread draws another, and the third holds the newest finished frame, so
+// neither side waits for the other to release a slot.
+//
+// Raylib input and GL stay on the main thread: input is sampled there and handed to the
+// simulation while the worker is idle, and the simulation only writes its frame slot.
+struct FramePipeline {
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::function<void(int)> simulate;  // Fills frame slot n; runs on the worker
+    int writeSlot = 0;                  // Worker's slot while a simulation runs
+    int readySlot = 1;                  // Newest finished frame
+    int readSlot = 2;                   // Main thread's slot between Acquires
+    bool requested = false;             // Kicked and not yet finished
+    bool fresh = false;                 // readySlot hasn't been acquired yet
+    bool stopping = false;
+    bool primed = false;                // readSlot holds a finished frame
+    float finishedMs = 0.0f;            // Duration of the simulation in readySlot
+    
+    bool threaded = true;               // False simulates inline, without the frame of latency
+    float simMs = 0.0f;                 // Duration of the simulation last acquired
+    
+    FramePipeline() = default;
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+    ~FramePipeline() { Stop(); }
+    
+    void Start(const std::function<void(int)>& fn);
+    void Stop();
+    
+    // Once per frame on the main thread: hand the next frame to the simulation and return
+    // the slot to draw. handOver runs while the worker is idle and should copy this frame's
+    // input (and apply any main-thread changes to state the simulation reads).
+    // Threaded, the slot returned is the one simulated from the previous frame's input.
+    int Advance(const std::function<void()>& handOver);
+    
+    void Kick();
+    int Acquire();
+    void WorkerLoop();
+};
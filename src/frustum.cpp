@@ -0,0 +1,67 @@
+// frustum.cpp - View frustum planes and bounds tests for culling
+
+#include "frustum.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include <cmath>
+
+static Vector4 NormalizePlane(float a, float b, float c, float d) {
+    float length = sqrtf(a * a + b * b + c * c);
+    if (length > 0.0f) { a /= length; b /= length; c /= length; d /= length; }
+    return { a, b, c, d };
+}
+
+Frustum FrustumFromMatrix(Matrix m) {
+    // Clip coordinates are rows of the matrix applied to (x, y, z, 1); a point is
+    // inside when -w <= x, y, z <= w, giving one plane per side (Gribb/Hartmann)
+    Frustum frustum;
+    frustum.planes[0] = NormalizePlane(m.m3 + m.m0, m.m7 + m.m4, m.m11 + m.m8, m.m15 + m.m12);   // Left
+    frustum.planes[1] = NormalizePlane(m.m3 - m.m0, m.m7 - m.m4, m.m11 - m.m8, m.m15 - m.m12);   // Right
+    frustum.planes[2] = NormalizePlane(m.m3 + m.m1, m.m7 + m.m5, m.m11 + m.m9, m.m15 + m.m13);   // Bottom
+    frustum.planes[3] = NormalizePlane(m.m3 - m.m1, m.m7 - m.m5, m.m11 - m.m9, m.m15 - m.m13);   // Top
+    frustum.planes[4] = NormalizePlane(m.m3 + m.m2, m.m7 + m.m6, m.m11 + m.m10, m.m15 + m.m14);  // Near
+    frustum.planes[5] = NormalizePlane(m.m3 - m.m2, m.m7 - m.m6, m.m11 - m.m10, m.m15 - m.m14);  // Far
+    return frustum;
+}
+
+Matrix GetCameraViewProjection(Camera3D camera, float aspect) {
+    Matrix view = MatrixLookAt(camera.position, camera.target, camera.up);
+    Matrix projection;
+    if (camera.projection == CAMERA_ORTHOGRAPHIC) {
+        double top = camera.fovy / 2.0;
+        double right = top * aspect;
+        projection = MatrixOrtho(-right, right, -top, top, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+    } else {
+        projection = MatrixPerspective(camera.fovy * DEG2RAD, aspect, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+    }
+    return MatrixMultiply(view, projection);
+}
+
+Frustum GetCameraFrustum(Camera3D camera, float aspect) {
+    return FrustumFromMatrix(GetCameraViewProjection(camera, aspect));
+}
+
+int FrustumClassifyBox(const Frustum& frustum, Vector3 min, Vector3 max) {
+    int result = FRUSTUM_INSIDE;
+    for (const Vector4& p : frustum.planes) {
+        // Corner furthest along the plane normal, then the one furthest against it
+        float furthest = p.x * (p.x >= 0.0f ? max.x : min.x) + p.y * (p.y >= 0.0f ? max.y : min.y) +
+                         p.z * (p.z >= 0.0f ? max.z : min.z) + p.w;
+        if (furthest < 0.0f) return FRUSTUM_OUTSIDE;
+        float nearest = p.x * (p.x >= 0.0f ? min.x : max.x) + p.y * (p.y >= 0.0f ? min.y : max.y) +
+                        p.z * (p.z >= 0.0f ? min.z : max.z) + p.w;
+        if (nearest < 0.0f) result = FRUSTUM_INTERSECTS;
+    }
+    return result;
+}
+
+bool FrustumContainsBox(const Frustum& frustum, BoundingBox box) {
+    return FrustumClassifyBox(frustum, box.min, box.max) != FRUSTUM_OUTSIDE;
+}
+
+bool FrustumContainsSphere(const Frustum& frustum, Vector3 center, float radius) {
+    for (const Vector4& p : frustum.planes) {
+        if (p.x * center.x + p.y * center.y + p.z * center.z + p.w < -radius) return false;
+    }
+    return true;
+}
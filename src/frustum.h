@@ -0,0 +1,29 @@
+// frustum.h - View frustum planes and bounds tests for culling
+#pragma once
+
+#include "raylib.h"
+
+// Result of classifying a box against the frustum
+const int FRUSTUM_OUTSIDE = 0;
+const int FRUSTUM_INTERSECTS = 1;
+const int FRUSTUM_INSIDE = 2;
+
+// Six planes (left, right, bottom, top, near, far) as ax + by + cz + d with
+// normals pointing into the frustum and normalized, so plane distance is in world units.
+struct Frustum {
+    Vector4 planes[6];
+};
+
+// Planes of a combined view-projection matrix (raylib order: MatrixMultiply(view, projection))
+Frustum FrustumFromMatrix(Matrix viewProjection);
+
+// View-projection BeginMode3D would use for this camera on a target with the given aspect ratio
+Matrix GetCameraViewProjection(Camera3D camera, float aspect);
+Frustum GetCameraFrustum(Camera3D camera, float aspect);
+
+// OUTSIDE if the box lies entirely behind one plane, INSIDE if entirely in front of all six.
+// Boxes near frustum corners can report INTERSECTS while outside (conservative).
+int FrustumClassifyBox(const Frustum& frustum, Vector3 min, Vector3 max);
+
+bool FrustumContainsBox(const Frustum& frustum, BoundingBox box);
+bool FrustumContainsSphere(const Frustum& frustum, Vector3 center, float radius);
@@ -0,0 +1,82 @@
+// gl_lines.cpp - Persistent line-list buffers drawn with the default shader
+
+#include "gl_lines.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include <GLFW/glfw3.h>
+
+#if defined(_WIN32)
+#define GL_LINES_APIENTRY __stdcall
+#else
+#define GL_LINES_APIENTRY
+#endif
+typedef void (GL_LINES_APIENTRY *DrawArraysFn)(unsigned int mode, int first, int count);
+typedef void (GL_LINES_APIENTRY *DrawArraysInstancedFn)(unsigned int mode, int first, int count, int instanceCount);
+
+static DrawArraysFn drawArrays = nullptr;
+static DrawArraysInstancedFn drawArraysInstanced = nullptr;
+
+bool LoadLineDrawProcs() {
+    if (!drawArrays) {
+        drawArrays = (DrawArraysFn)glfwGetProcAddress("glDrawArrays");
+        drawArraysInstanced = (DrawArraysInstancedFn)glfwGetProcAddress("glDrawArraysInstanced");
+        if (!drawArrays) TraceLog(LOG_WARNING, "GL lines: glDrawArrays unavailable, using immediate mode");
+    }
+    return drawArrays != nullptr;
+}
+
+bool LineDrawsAvailable() {
+    return drawArrays != nullptr;
+}
+
+bool InstancedLineDrawsAvailable() {
+    return drawArraysInstanced != nullptr;
+}
+
+unsigned int LoadLineArray(const std::vector<LineVertex>& vertices, unsigned int* vbo) {
+    int* locs = rlGetShaderLocsDefault();
+    int positionLoc = locs[SHADER_LOC_VERTEX_POSITION];
+    int colorLoc = locs[SHADER_LOC_VERTEX_COLOR];
+
+    unsigned int vao = rlLoadVertexArray();
+    rlEnableVertexArray(vao);
+    *vbo = rlLoadVertexBuffer(vertices.data(), (int)(vertices.size() * sizeof(LineVertex)), false);
+    rlSetVertexAttribute(positionLoc, 3, RL_FLOAT, false, (int)sizeof(LineVertex), 0);
+    rlEnableVertexAttribute(positionLoc);
+    rlSetVertexAttribute(colorLoc, 4, RL_UNSIGNED_BYTE, true, (int)sizeof(LineVertex), 12);
+    rlEnableVertexAttribute(colorLoc);
+    rlDisableVertexArray();
+    return vao;
+}
+
+void UnloadLineArray(unsigned int vao, unsigned int vbo) {
+    if (vbo != 0) rlUnloadVertexBuffer(vbo);
+    if (vao != 0) rlUnloadVertexArray(vao);
+}
+
+void BeginLineArrays() {
+    // The default shader samples texture0, so the white default texture must be bound
+    int* locs = rlGetShaderLocsDefault();
+    Matrix mvp = MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection());
+    float white[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    rlEnableShader(rlGetShaderIdDefault());
+    rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_MVP], mvp);
+    rlSetUniform(locs[SHADER_LOC_COLOR_DIFFUSE], white, RL_SHADER_UNIFORM_VEC4, 1);
+    rlActiveTextureSlot(0);
+    rlEnableTexture(rlGetTextureIdDefault());
+}
+
+void DrawLineArray(unsigned int vao, int first, int count) {
+    rlEnableVertexArray(vao);
+    drawArrays(RL_LINES, first, count);
+}
+
+void EndLineArrays() {
+    rlDisableVertexArray();
+    rlDisableTexture();
+    rlDisableShader();
+}
+
+void DrawLinesInstanced(int first, int count, int instances) {
+    drawArraysInstanced(RL_LINES, first, count, instances);
+}
@@ -0,0 +1,32 @@
+// gl_lines.h - Persistent line-list buffers drawn with the default shader
+#pragma once
+
+#include "raylib.h"
+#include <vector>
+
+// rlgl only draws vertex arrays as triangles; line buffers go through GL directly
+// with entry points fetched from GLFW once a context exists.
+
+// Interleaved line vertex (16 bytes), matching the default shader's position + color inputs
+struct LineVertex {
+    Vector3 position;
+    Color color;
+};
+
+// Fetch the GL entry points (needs a GL context). Returns false if line draws are unavailable,
+// in which case callers fall back to rlgl immediate mode.
+bool LoadLineDrawProcs();
+bool LineDrawsAvailable();
+bool InstancedLineDrawsAvailable();
+
+// Upload a line list into a new vertex array bound to the default shader. Returns the VAO id.
+unsigned int LoadLineArray(const std::vector<LineVertex>& vertices, unsigned int* vbo);
+void UnloadLineArray(unsigned int vao, unsigned int vbo);
+
+// Default shader, white texture and the current modelview-projection for DrawLineArray calls
+void BeginLineArrays();
+void DrawLineArray(unsigned int vao, int first, int count);
+void EndLineArrays();
+
+// Instanced GL_LINES for callers with their own shader and vertex array bound
+void DrawLinesInstanced(int first, int count, int instances);
@@ -0,0 +1,94 @@
+// gpu_timer.cpp - GL timer queries for the GPU time of a span of draw calls
+
+#include "gpu_timer.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include <GLFW/glfw3.h>
+#include <cstdint>
+
+#if defined(_WIN32)
+#define GPU_TIMER_APIENTRY __stdcall
+#else
+#define GPU_TIMER_APIENTRY
+#endif
+typedef void (GPU_TIMER_APIENTRY *GenQueriesFn)(int n, unsigned int* ids);
+typedef void (GPU_TIMER_APIENTRY *DeleteQueriesFn)(int n, const unsigned int* ids);
+typedef void (GPU_TIMER_APIENTRY *BeginQueryFn)(unsigned int target, unsigned int id);
+typedef void (GPU_TIMER_APIENTRY *EndQueryFn)(unsigned int target);
+typedef void (GPU_TIMER_APIENTRY *GetQueryObjectivFn)(unsigned int id, unsigned int pname, int* params);
+typedef void (GPU_TIMER_APIENTRY *GetQueryObjectui64vFn)(unsigned int id, unsigned int pname, uint64_t* params);
+
+// GL 3.3 / ARB_timer_query enums
+static const unsigned int TIME_ELAPSED = 0x88BF;
+static const unsigned int QUERY_RESULT = 0x8866;
+static const unsigned int QUERY_RESULT_AVAILABLE = 0x8867;
+
+static GenQueriesFn genQueries = nullptr;
+static DeleteQueriesFn deleteQueries = nullptr;
+static BeginQueryFn beginQuery = nullptr;
+static EndQueryFn endQuery = nullptr;
+static GetQueryObjectivFn getQueryObjectiv = nullptr;
+static GetQueryObjectui64vFn getQueryObjectui64v = nullptr;
+
+static bool LoadQueryProcs() {
+    if (!genQueries) {
+        genQueries = (GenQueriesFn)glfwGetProcAddress("glGenQueries");
+        deleteQueries = (DeleteQueriesFn)glfwGetProcAddress("glDeleteQueries");
+        beginQuery = (BeginQueryFn)glfwGetProcAddress("glBeginQuery");
+        endQuery = (EndQueryFn)glfwGetProcAddress("glEndQuery");
+        getQueryObjectiv = (GetQueryObjectivFn)glfwGetProcAddress("glGetQueryObjectiv");
+        getQueryObjectui64v = (GetQueryObjectui64vFn)glfwGetProcAddress("glGetQueryObjectui64v");
+    }
+    return genQueries && deleteQueries && beginQuery && endQuery && getQueryObjectiv && getQueryObjectui64v;
+}
+
+void GpuTimer::Load() {
+    Unload();
+    if (!LoadQueryProcs()) {
+        TraceLog(LOG_WARNING, "GpuTimer: timer queries unavailable, GPU times not measured");
+        return;
+    }
+    genQueries(GPU_TIMER_FRAMES, queries);
+    ready = true;
+}
+
+void GpuTimer::Unload() {
+    if (ready) deleteQueries(GPU_TIMER_FRAMES, queries);
+    for (int i = 0; i < GPU_TIMER_FRAMES; i++) {
+        queries[i] = 0;
+        issued[i] = false;
+    }
+    next = 0;
+    active = ready = false;
+    ms = 0.0f;
+}
+
+void GpuTimer::Begin() {
+    if (!ready || active) return;
+    
+    // Collect finished queries oldest first, so ms ends up with the newest result
+    for (int k = 0; k < GPU_TIMER_FRAMES; k++) {
+        int i = (next + k) % GPU_TIMER_FRAMES;
+        if (!issued[i]) continue;
+        int available = 0;
+        getQueryObjectiv(queries[i], QUERY_RESULT_AVAILABLE, &available);
+        if (!available) continue;
+        uint64_t nanoseconds = 0;
+        getQueryObjectui64v(queries[i], QUERY_RESULT, &nanoseconds);
+        ms = (float)((double)nanoseconds / 1000000.0);
+        issued[i] = false;
+    }
+    
+    rlDrawRenderBatchActive();
+    beginQuery(TIME_ELAPSED, queries[next]);
+    active = true;
+}
+
+void GpuTimer::End() {
+    if (!active) return;
+    rlDrawRenderBatchActive();
+    endQuery(TIME_ELAPSED);
+    issued[next] = true;
+    next = (next + 1) % GPU_TIMER_FRAMES;
+    active = false;
+}
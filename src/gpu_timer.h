@@ -0,0 +1,26 @@
+// gpu_timer.h - GL timer queries for the GPU time of a span of draw calls
+#pragma once
+
+// Queries in flight per timer; a result is read back at most this many frames late
+const int GPU_TIMER_FRAMES = 4;
+
+// Measures the GPU time of the draw calls between Begin and End without stalling: each
+// Begin takes the next query of a small ring and collects whichever earlier ones have
+// finished. Spans of different timers must not nest or overlap (one GL_TIME_ELAPSED query
+// can be active at a time). Without timer query support, ready stays false and ms 0.
+struct GpuTimer {
+    unsigned int queries[GPU_TIMER_FRAMES] = {};
+    bool issued[GPU_TIMER_FRAMES] = {};
+    int next = 0;                   // Ring slot the next Begin uses (the oldest)
+    bool active = false;            // Between Begin and End
+    bool ready = false;             // Queries created
+    float ms = 0.0f;                // Most recent result
+    
+    // Create the queries (needs a GL context)
+    void Load();
+    void Unload();
+    
+    // Both flush rlgl's batch so only the span's draws are counted
+    void Begin();
+    void End();
+};
@@ -0,0 +1,50 @@
+// grid_mesh.cpp - Ground grid uploaded once as a GPU line list
+
+#include "grid_mesh.h"
+#include "gl_lines.h"
+#include <vector>
+
+void GridMesh::Load(int gridSlices, float gridSpacing) {
+    Unload();
+    slices = gridSlices;
+    spacing = gridSpacing;
+    LoadLineDrawProcs();
+    
+    // DrawGrid layout: the center lines darker, the rest light gray, on y = 0
+    int halfSlices = slices / 2;
+    float extent = (float)halfSlices * spacing;
+    Color centerColor = { 127, 127, 127, 255 };
+    Color lineColor = { 191, 191, 191, 255 };
+    
+    std::vector<LineVertex> vertices;
+    vertices.reserve((halfSlices * 2 + 1) * 4);
+    for (int i = -halfSlices; i <= halfSlices; i++) {
+        Color color = (i == 0) ? centerColor : lineColor;
+        float offset = (float)i * spacing;
+        vertices.push_back({ { offset, 0.0f, -extent }, color });
+        vertices.push_back({ { offset, 0.0f, extent }, color });
+        vertices.push_back({ { -extent, 0.0f, offset }, color });
+        vertices.push_back({ { extent, 0.0f, offset }, color });
+    }
+    vertexCount = (int)vertices.size();
+    
+    if (LineDrawsAvailable()) vao = LoadLineArray(vertices, &vbo);
+}
+
+void GridMesh::Unload() {
+    UnloadLineArray(vao, vbo);
+    vao = vbo = 0;
+    vertexCount = 0;
+}
+
+int GridMesh::Draw() const {
+    if (vao == 0) {
+        // No GL line entry point: immediate mode, as before
+        if (slices > 0) DrawGrid(slices, spacing);
+        return 1;
+    }
+    BeginLineArrays();
+    DrawLineArray(vao, 0, vertexCount);
+    EndLineArrays();
+    return 1;
+}
@@ -0,0 +1,21 @@
+// grid_mesh.h - Ground grid uploaded once as a GPU line list
+#pragma once
+
+#include "raylib.h"
+
+// Replacement for DrawGrid: same lines and colours, but built once into a vertex buffer
+// and drawn with a single call instead of regenerating every vertex each frame.
+struct GridMesh {
+    unsigned int vao = 0;
+    unsigned int vbo = 0;
+    int vertexCount = 0;
+    int slices = 0;                 // Lines per axis beyond the center line, as in DrawGrid
+    float spacing = 0.0f;
+    
+    // Build the grid (needs a GL context); call again to change extent or spacing
+    void Load(int slices, float spacing);
+    void Unload();
+    
+    // Draw between BeginMode3D/EndMode3D. Returns the draw calls issued.
+    int Draw() const;
+};
@@ -0,0 +1,52 @@
+// hud_panel.cpp - HUD widgets rendered into a retained texture
+
+#include "hud_panel.h"
+#include "rlgl.h"
+
+void HudPanel::Load(int width, int height, float interval) {
+    Unload();
+    target = LoadRenderTexture(width, height);
+    refreshInterval = interval;
+}
+
+void HudPanel::Unload() {
+    if (target.id != 0) UnloadRenderTexture(target);
+    target = { 0 };
+    valid = false;
+}
+
+bool HudPanel::BeginRefresh(unsigned int contentKey, double now) {
+    bool expired = refreshInterval > 0.0f && now - lastRefresh >= refreshInterval;
+    if (valid && contentKey == key && !expired) return false;
+    
+    key = contentKey;
+    lastRefresh = now;
+    valid = true;
+    
+    BeginTextureMode(target);
+    ClearBackground(BLANK);
+    // Regular alpha blending for colour but accumulate coverage in alpha, leaving the
+    // texture premultiplied so translucent backgrounds composite exactly as before
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+                              RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+    return true;
+}
+
+void HudPanel::EndRefresh() {
+    EndBlendMode();
+    EndTextureMode();
+}
+
+void HudPanel::Invalidate() {
+    valid = false;
+}
+
+void HudPanel::Draw(int x, int y) const {
+    if (target.id == 0) return;
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawTextureRec(target.texture,
+        (Rectangle){ 0, 0, (float)target.texture.width, -(float)target.texture.height },
+        (Vector2){ (float)x, (float)y }, WHITE);
+    EndBlendMode();
+}
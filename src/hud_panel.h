@@ -0,0 +1,30 @@
+// hud_panel.h - HUD widgets rendered into a retained texture
+#pragma once
+
+#include "raylib.h"
+
+const float HUD_REFRESH_INTERVAL = 0.1f;    // Numeric readouts redraw at 10 Hz
+
+// A screen-space panel whose contents are drawn into a render texture and reused
+// across frames. The texture is redrawn when the caller's key changes (mode flags,
+// toggles) or when the refresh interval elapses; every other frame is one textured quad.
+struct HudPanel {
+    RenderTexture2D target = { 0 };
+    float refreshInterval = 0.0f;   // Seconds between timed redraws, 0 = only when the key changes
+    double lastRefresh = 0.0;
+    unsigned int key = 0;
+    bool valid = false;             // Texture holds contents for key
+    
+    void Load(int width, int height, float interval);
+    void Unload();
+    
+    // Returns true if the panel must be redrawn, with the texture bound and cleared:
+    // draw the contents in panel coordinates, then call EndRefresh.
+    bool BeginRefresh(unsigned int contentKey, double now);
+    void EndRefresh();
+    
+    // Mark the contents stale so the next BeginRefresh redraws
+    void Invalidate();
+    
+    void Draw(int x, int y) const;
+};
@@ -0,0 +1,107 @@
+// input_script.cpp - Recorded/generated per-tick input for replaying the player controllers
+
+#include "input_script.h"
+#include "level.h"
+#include <cstdio>
+#include <cstring>
+
+static const char* INPUT_SCRIPT_HEADER = "# mavish input script";
+static const char INPUT_SCRIPT_FLAGS[] = "FBLRUDSJ";
+
+static bool* InputFlag(PlayerInput* input, int flag) {
+    bool* flags[] = {
+        &input->forward, &input->back, &input->left, &input->right,
+        &input->up, &input->down, &input->sprint, &input->jump
+    };
+    return flags[flag];
+}
+
+bool InputScript::Load(const char* fileName) {
+    FILE* file = fopen(fileName, "r");
+    if (!file) {
+        TraceLog(LOG_WARNING, "INPUT: Failed to open script %s", fileName);
+        return false;
+    }
+    
+    ticks.clear();
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        if (line[0] == '#') {
+            sscanf(line, "# rate %d", &physicsRate);
+            continue;
+        }
+        
+        PlayerInput input = {};
+        char keys[16] = "";
+        if (sscanf(line, "%f %f %15s", &input.look.x, &input.look.y, keys) < 2) continue;
+        
+        for (int i = 0; keys[i] != '\0'; i++) {
+            const char* flag = strchr(INPUT_SCRIPT_FLAGS, keys[i]);
+            if (flag) *InputFlag(&input, (int)(flag - INPUT_SCRIPT_FLAGS)) = true;
+        }
+        ticks.push_back(input);
+    }
+    fclose(file);
+    
+    TraceLog(LOG_INFO, "INPUT: Loaded %d ticks at %d Hz from %s", (int)ticks.size(), physicsRate, fileName);
+    return true;
+}
+
+bool InputScript::Save(const char* fileName) const {
+    FILE* file = fopen(fileName, "w");
+    if (!file) {
+        TraceLog(LOG_WARNING, "INPUT: Failed to write script %s", fileName);
+        return false;
+    }
+    
+    fprintf(file, "%s\n# rate %d\n", INPUT_SCRIPT_HEADER, physicsRate);
+    for (const PlayerInput& tick : ticks) {
+        PlayerInput input = tick;
+        char keys[16];
+        int keyCount = 0;
+        for (int i = 0; INPUT_SCRIPT_FLAGS[i] != '\0'; i++) {
+            if (*InputFlag(&input, i)) keys[keyCount++] = INPUT_SCRIPT_FLAGS[i];
+        }
+        if (keyCount == 0) keys[keyCount++] = '-';
+        keys[keyCount] = '\0';
+        fprintf(file, "%.9g %.9g %s\n", input.look.x, input.look.y, keys);
+    }
+    fclose(file);
+    
+    TraceLog(LOG_INFO, "INPUT: Saved %d ticks to %s", (int)ticks.size(), fileName);
+    return true;
+}
+
+void InputScript::Generate(int tickCount, unsigned int seed) {
+    unsigned int state = seed;
+    ticks.clear();
+    ticks.reserve(tickCount);
+    
+    PlayerInput held = {};
+    bool standStill = false;
+    float turnRate = 0.0f;
+    int ticksLeft = 0;
+    
+    for (int i = 0; i < tickCount; i++) {
+        // Pick a new action every 0.25 - 2 seconds of ticks; some are just looking around
+        if (ticksLeft <= 0) {
+            held = {};
+            standStill = NextRandom(&state) < 0.2f;
+            if (!standStill) {
+                held.forward = NextRandom(&state) < 0.8f;
+                held.back = !held.forward && NextRandom(&state) < 0.5f;
+                held.left = NextRandom(&state) < 0.2f;
+                held.right = !held.left && NextRandom(&state) < 0.2f;
+                held.sprint = NextRandom(&state) < 0.3f;
+            }
+            turnRate = (NextRandom(&state) * 2.0f - 1.0f) * 3.0f;
+            ticksLeft = physicsRate / 4 + (int)(NextRandom(&state) * (float)physicsRate * 1.75f);
+        }
+        ticksLeft--;
+        
+        PlayerInput input = held;
+        input.look = { turnRate, 0.0f };
+        input.jump = !standStill && NextRandom(&state) < 0.02f;
+        ticks.push_back(input);
+    }
+}
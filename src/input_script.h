@@ -0,0 +1,20 @@
+// input_script.h - Recorded/generated per-tick input for replaying the player controllers
+#pragma once
+
+#include "player.h"
+#include <vector>
+
+// A sequence of PlayerInput, one entry per physics tick
+// Text format, one tick per line: "lookX lookY keys" where keys is a string of
+// flags from "FBLRUDSJ" (forward, back, left, right, up, down, sprint, jump) or "-"
+struct InputScript {
+    int physicsRate = 60;               // Tick rate the script was recorded at
+    std::vector<PlayerInput> ticks;
+    
+    bool Load(const char* fileName);
+    bool Save(const char* fileName) const;
+    
+    // Synthesize a wandering walk: runs of movement keys, occasional jumps and sprints,
+    // pauses to look around, and smooth turning. Deterministic for a given seed.
+    void Generate(int tickCount, unsigned int seed);
+};
@@ -0,0 +1,145 @@
+// instance_batch.cpp - Instanced drawing of shared meshes with per-instance transform and colour
+
+#include "instance_batch.h"
+#include "rlgl.h"
+
+static_assert(sizeof(MeshInstance) == 68, "MeshInstance must match the instance attribute layout");
+
+void InstanceBatch::Load() {
+    shader = LoadShader("resources/shaders/instanced.vs", "resources/shaders/instanced.fs");
+    mvpLoc = GetShaderLocation(shader, "mvp");
+    transformLoc = GetShaderLocationAttrib(shader, "instanceTransform");
+    colorLoc = GetShaderLocationAttrib(shader, "instanceColor");
+    material = LoadMaterialDefault();
+    
+    ready = shader.id != rlGetShaderIdDefault() && mvpLoc >= 0 &&
+            transformLoc == INSTANCE_TRANSFORM_LOCATION && colorLoc == INSTANCE_COLOR_LOCATION;
+    if (!ready) TraceLog(LOG_WARNING, "InstanceBatch: instancing shader unavailable, drawing per object");
+}
+
+void InstanceBatch::Unload() {
+    if (instanceVbo != 0) rlUnloadVertexBuffer(instanceVbo);
+    if (shader.id != 0 && shader.id != rlGetShaderIdDefault()) UnloadShader(shader);
+    // The default material shares the default shader; only its map array is ours
+    if (material.maps != nullptr) UnloadMaterial(material);
+    shader = { 0 };
+    material = { 0 };
+    instanceVbo = 0;
+    instanceCapacity = 0;
+    ready = false;
+}
+
+void InstanceList::Begin() {
+    for (InstanceGroup& group : groups) {
+        group.transforms.clear();
+        group.colors.clear();
+    }
+    instanceCount = 0;
+}
+
+void InstanceList::Add(const Mesh& mesh, Matrix transform, Color color) {
+    InstanceGroup* group = nullptr;
+    for (InstanceGroup& candidate : groups) {
+        if (candidate.mesh.vaoId == mesh.vaoId) { group = &candidate; break; }
+    }
+    if (!group) {
+        groups.push_back({ mesh, {}, {} });
+        group = &groups.back();
+    }
+    group->transforms.push_back(transform);
+    group->colors.push_back(color);
+    instanceCount++;
+}
+
+// Attach the instance buffer slice starting at first to the bound vertex array
+static void PointInstanceAttributes(int transformLoc, int colorLoc, int first) {
+    int stride = (int)sizeof(MeshInstance);
+    int base = first * stride;
+    for (int column = 0; column < 4; column++) {
+        rlSetVertexAttribute(transformLoc + column, 4, RL_FLOAT, false, stride, base + column * 16);
+        rlEnableVertexAttribute(transformLoc + column);
+        rlSetVertexAttributeDivisor(transformLoc + column, 1);
+    }
+    rlSetVertexAttribute(colorLoc, 4, RL_UNSIGNED_BYTE, true, stride, base + 64);
+    rlEnableVertexAttribute(colorLoc);
+    rlSetVertexAttributeDivisor(colorLoc, 1);
+}
+
+// Disable the instance attributes again; their locations are unused by DrawMesh, so the
+// shared mesh's vertex array is left as it expects
+static void ReleaseInstanceAttributes(int transformLoc, int colorLoc) {
+    for (int column = 0; column < 4; column++) {
+        rlSetVertexAttributeDivisor(transformLoc + column, 0);
+        rlDisableVertexAttribute(transformLoc + column);
+    }
+    rlSetVertexAttributeDivisor(colorLoc, 0);
+    rlDisableVertexAttribute(colorLoc);
+}
+
+int InstanceBatch::Draw(const InstanceList& list) {
+    if (list.instanceCount == 0) return 0;
+    int drawCalls = 0;
+    
+    if (!ready || !instancing) {
+        for (const InstanceGroup& group : list.groups) {
+            for (size_t i = 0; i < group.transforms.size(); i++) {
+                material.maps[MATERIAL_MAP_DIFFUSE].color = group.colors[i];
+                DrawMesh(group.mesh, material, group.transforms[i]);
+                drawCalls++;
+            }
+        }
+        return drawCalls;
+    }
+    
+    // One upload for every group, in group order
+    staging.clear();
+    for (const InstanceGroup& group : list.groups) {
+        for (size_t i = 0; i < group.transforms.size(); i++) {
+            staging.push_back({ MatrixToFloatV(group.transforms[i]), group.colors[i] });
+        }
+    }
+    int bytes = (int)(staging.size() * sizeof(MeshInstance));
+    if ((int)staging.size() > instanceCapacity) {
+        if (instanceVbo != 0) rlUnloadVertexBuffer(instanceVbo);
+        instanceVbo = rlLoadVertexBuffer(staging.data(), bytes, true);
+        instanceCapacity = (int)staging.size();
+    } else {
+        rlUpdateVertexBuffer(instanceVbo, staging.data(), bytes, 0);
+    }
+    
+    // Same view-projection raylib uses for DrawMesh; the model matrix is per instance
+    Matrix mvp = MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection());
+    rlEnableShader(shader.id);
+    rlSetUniformMatrix(mvpLoc, mvp);
+    
+    int first = 0;
+    for (const InstanceGroup& group : list.groups) {
+        int count = (int)group.transforms.size();
+        if (count == 0) continue;
+        
+        rlEnableVertexArray(group.mesh.vaoId);
+        rlEnableVertexBuffer(instanceVbo);
+        PointInstanceAttributes(transformLoc, colorLoc, first);
+        if (group.mesh.indices != nullptr) {
+            rlDrawVertexArrayElementsInstanced(0, group.mesh.triangleCount * 3, 0, count);
+        } else {
+            rlDrawVertexArrayInstanced(0, group.mesh.vertexCount, count);
+        }
+        ReleaseInstanceAttributes(transformLoc, colorLoc);
+        
+        first += count;
+        drawCalls++;
+    }
+    
+    rlDisableVertexBuffer();
+    rlDisableVertexArray();
+    rlDisableShader();
+    return drawCalls;
+}
+
+Matrix InstanceTransform(Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale) {
+    Matrix matScale = MatrixScale(scale.x, scale.y, scale.z);
+    Matrix matRotation = MatrixRotate(rotationAxis, rotationAngle * DEG2RAD);
+    Matrix matTranslation = MatrixTranslate(position.x, position.y, position.z);
+    return MatrixMultiply(MatrixMultiply(matScale, matRotation), matTranslation);
+}
@@ -0,0 +1,61 @@
+// instance_batch.h - Instanced drawing of shared meshes with per-instance transform and colour
+#pragma once
+
+#include "raylib.h"
+#include "raymath.h"
+#include <vector>
+
+// Instance attribute locations, fixed in instanced.vs. Above raylib's mesh attributes
+// (0-7), so pointing them inside a shared mesh's vertex array leaves DrawMesh's intact.
+const int INSTANCE_TRANSFORM_LOCATION = 8;     // mat4: 8-11
+const int INSTANCE_COLOR_LOCATION = 12;
+
+// Per-instance data as laid out in the GPU buffer (68 bytes): column-major model matrix, colour
+struct MeshInstance {
+    float16 transform;
+    Color color;
+};
+
+// Instances submitted for one mesh this frame
+struct InstanceGroup {
+    Mesh mesh;
+    std::vector<Matrix> transforms;
+    std::vector<Color> colors;
+};
+
+// Objects collected by mesh during a frame. Meshes are matched by VAO, so they must be
+// shared (see MeshCache) for objects to batch. Filling a list makes no GL calls, so it
+// can be built on the simulation thread and drawn later by InstanceBatch.
+struct InstanceList {
+    std::vector<InstanceGroup> groups;  // Kept between frames so their storage is reused
+    int instanceCount = 0;          // Objects added since Begin
+    
+    void Begin();
+    void Add(const Mesh& mesh, Matrix transform, Color color);
+};
+
+// Draws each mesh of an InstanceList once with all its instances, replacing a DrawModel
+// per object. All instances go into one buffer per frame and each group is drawn by
+// pointing the instance attributes at its slice.
+struct InstanceBatch {
+    Shader shader = { 0 };
+    int mvpLoc = -1;
+    int transformLoc = -1;          // mat4: four consecutive attribute locations
+    int colorLoc = -1;
+    unsigned int instanceVbo = 0;
+    int instanceCapacity = 0;
+    Material material = { 0 };      // Per-object fallback
+    bool ready = false;             // False if the shader failed; Draw falls back to DrawMesh
+    bool instancing = true;         // False draws one DrawMesh per object for comparison
+    std::vector<MeshInstance> staging;
+    
+    // Load the shader (needs a GL context)
+    void Load();
+    void Unload();
+    
+    // Draw the list; call between BeginMode3D/EndMode3D. Returns the draw calls issued.
+    int Draw(const InstanceList& list);
+};
+
+// Model matrix DrawModelEx builds for a model with an identity transform
+Matrix InstanceTransform(Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale);
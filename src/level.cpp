@@ -0,0 +1,53 @@
+// level.cpp - Level construction shared by the game and the headless bench
+
+#include "level.h"
+#include <cstdlib>
+
+void BuildDemoLevel(std::vector<CollisionBox>& boxes) {
+    // Main center cube
+    CollisionBox centerCube;
+    centerCube.position = { 0.0f, 1.0f, 0.0f };
+    centerCube.size = { 2.0f, 2.0f, 2.0f };
+    centerCube.color = RED;
+    centerCube.wireColor = MAROON;
+    boxes.push_back(centerCube);
+    
+    // Pillars
+    for (int i = -5; i <= 5; i += 2) {
+        for (int j = -5; j <= 5; j += 2) {
+            if (i == 0 && j == 0) continue;
+            float height = 1.0f + (float)(abs(i + j) % 3);
+            CollisionBox pillar;
+            pillar.position = { (float)i * 3.0f, height / 2.0f, (float)j * 3.0f };
+            pillar.size = { 0.5f, height, 0.5f };
+            pillar.color = BLUE;
+            pillar.wireColor = DARKBLUE;
+            boxes.push_back(pillar);
+        }
+    }
+}
+
+float NextRandom(unsigned int* state) {
+    *state = *state * 1664525u + 1013904223u;
+    return (float)(*state >> 8) / 16777216.0f;
+}
+
+void AddBoxField(std::vector<CollisionBox>& boxes, int count, float extent, unsigned int seed) {
+    unsigned int state = seed;
+    boxes.reserve(boxes.size() + count);
+    
+    for (int i = 0; i < count; i++) {
+        float sizeX = 0.5f + NextRandom(&state) * 2.0f;
+        float sizeY = 0.5f + NextRandom(&state) * 3.0f;
+        float sizeZ = 0.5f + NextRandom(&state) * 2.0f;
+        float x = (NextRandom(&state) * 2.0f - 1.0f) * extent;
+        float z = (NextRandom(&state) * 2.0f - 1.0f) * extent;
+        
+        CollisionBox box;
+        box.position = { x, sizeY / 2.0f, z };
+        box.size = { sizeX, sizeY, sizeZ };
+        box.color = GRAY;
+        box.wireColor = DARKGRAY;
+        boxes.push_back(box);
+    }
+}
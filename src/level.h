@@ -0,0 +1,16 @@
+// level.h - Level construction shared by the game and the headless bench
+#pragma once
+
+#include "collision.h"
+#include <vector>
+
+// Small LCG: advances *state and returns a float in [0, 1). Unlike rand() it gives the
+// same sequence on every platform, so levels, scripts and benches reproduce from a seed.
+float NextRandom(unsigned int* state);
+
+// Center cube plus the ring of pillars used by the main game
+void BuildDemoLevel(std::vector<CollisionBox>& boxes);
+
+// Scatter count random boxes over a square of half-width extent around the origin
+// Deterministic for a given seed so bench runs are comparable
+void AddBoxField(std::vector<CollisionBox>& boxes, int count, float extent, unsigned int seed);
@@ -1,10 +1,22 @@
 #include "raylib.h"
 #include "raymath.h"
+#include "player.h"
+#include "level.h"
+#include "input_script.h"
+#include "box_renderer.h"
+#include "static_batch.h"
+#include "grid_mesh.h"
+#include "hud_panel.h"
+#include "frame_graph.h"
+#include "frustum.h"
+#include "frame_pipeline.h"
 #include <cmath>
 #include <vector>
 #include <deque>
 #include <algorithm>
 #include <numeric>
+#include <cstdlib>
+#include <cstring>
 
 #define RAYGUI_IMPLEMENTATION
 #include "raygui.h"
@@ -25,8 +37,19 @@ struct GameSettings {
     int windowMode;         // 0=Windowed, 1=Borderless, 2=Exclusive
     int defaultWidth;
     int defaultHeight;
+    int physicsRate;        // Fixed physics ticks per second
 };
 
+// Fixed timestep limits
+const int MIN_PHYSICS_RATE = 30;
+const int MAX_PHYSICS_RATE = 240;
+const float MAX_FRAME_TIME = 0.25f;  // Longer frames are clamped so physics can't spiral
+
+// Ground drawn under the level
+const int GROUND_GRID_SLICES = 50;
+const float GROUND_GRID_SPACING = 1.0f;
+const float GROUND_PLANE_SIZE = 50.0f;
+
 // Performance monitoring structure
 struct PerformanceStats {
     std::deque<float> frameTimeHistory;  // Last N frame times
@@ -46,7 +69,7 @@ struct PerformanceStats {
     double totalTime;
     
     int drawCalls;           // Approximate draw calls
-    int collisionChecks;
+    float submitTime;        // Main thread: drawing from after the frame handoff to EndDrawing, ms
     
     void Update() {
         float dt = GetFrameTime();
@@ -84,7 +107,6 @@ struct PerformanceStats {
         frameTimeHistory.clear();
         frameCount = 0;
         totalTime = 0;
-        collisionChecks = 0;
     }
 };
 
@@ -149,269 +171,189 @@ void ApplyWindowMode(int mode, int defaultWidth, int defaultHeight) {
     TraceLog(LOG_INFO, "Window mode applied successfully");
 }
 
-// Player state structure
-struct Player {
-    Vector3 position;
-    Vector3 velocity;
-    float yaw;
-    float pitch;
-    float height;           // Player eye height
-    float radius;           // Collision radius
-    bool isGrounded;
-    bool noclipMode;
-};
-
-// Collision box structure
-struct CollisionBox {
-    Vector3 position;       // Center position
-    Vector3 size;           // Full size (width, height, depth)
-    Color color;
-    Color wireColor;
-};
-
-// Physics constants
-const float GRAVITY = 20.0f;
-const float JUMP_FORCE = 8.0f;
-const float GROUND_LEVEL = 0.0f;
-
-// Get bounding box from collision box
-BoundingBox GetBoxBounds(const CollisionBox& box) {
-    return {
-        { box.position.x - box.size.x/2, box.position.y - box.size.y/2, box.position.z - box.size.z/2 },
-        { box.position.x + box.size.x/2, box.position.y + box.size.y/2, box.position.z + box.size.z/2 }
-    };
-}
-
-// Check collision between player (cylinder approximated as box) and a collision box
-bool CheckPlayerBoxCollision(Vector3 playerPos, float radius, float height, const CollisionBox& box) {
-    BoundingBox playerBox = {
-        { playerPos.x - radius, playerPos.y - height, playerPos.z - radius },
-        { playerPos.x + radius, playerPos.y, playerPos.z + radius }
-    };
-    return CheckCollisionBoxes(playerBox, GetBoxBounds(box));
-}
-
-// Check if player should have horizontal collision with box (not if standing on top)
-bool ShouldApplyHorizontalCollision(Vector3 playerPos, float radius, float height, const CollisionBox& box) {
-    BoundingBox boxBounds = GetBoxBounds(box);
-    
-    // First check if there's any horizontal overlap
-    bool horizontalOverlap = 
-        (playerPos.x + radius > boxBounds.min.x) && (playerPos.x - radius < boxBounds.max.x) &&
-        (playerPos.z + radius > boxBounds.min.z) && (playerPos.z - radius < boxBounds.max.z);
-    
-    if (!horizontalOverlap) return false;
-    
-    // Player's feet position
-    float feetY = playerPos.y - height;
-    
-    // If player's feet are at or above the box top, they're standing on it - no horizontal collision
-    // Use a small tolerance to prevent edge cases
-    if (feetY >= boxBounds.max.y - 0.1f) {
-        return false;
-    }
-    
-    // If player's head is below box bottom, no collision (shouldn't happen but safety check)
-    if (playerPos.y < boxBounds.min.y) {
-        return false;
-    }
-    
-    // Player is at a height where horizontal collision should apply
-    return true;
-}
-
-// Resolve collision by pushing player out of box
-Vector3 ResolveCollision(Vector3 playerPos, float radius, float height, const CollisionBox& box) {
-    BoundingBox boxBounds = GetBoxBounds(box);
-    
-    // Calculate overlap on each axis
-    float overlapX1 = (playerPos.x + radius) - boxBounds.min.x;
-    float overlapX2 = boxBounds.max.x - (playerPos.x - radius);
-    float overlapZ1 = (playerPos.z + radius) - boxBounds.min.z;
-    float overlapZ2 = boxBounds.max.z - (playerPos.z - radius);
-    
-    // Find minimum overlap
-    float minOverlapX = (overlapX1 < overlapX2) ? -overlapX1 : overlapX2;
-    float minOverlapZ = (overlapZ1 < overlapZ2) ? -overlapZ1 : overlapZ2;
-    
-    // Push out on axis with smallest overlap
-    if (fabsf(minOverlapX) < fabsf(minOverlapZ)) {
-        playerPos.x += minOverlapX;
-    } else {
-        playerPos.z += minOverlapZ;
-    }
-    
-    return playerPos;
+// Sample the keyboard into a controller input (look is filled in by the caller)
+PlayerInput SampleInput(bool jumpQueued) {
+    PlayerInput input = {};
+    input.forward = IsKeyDown(KEY_W);
+    input.back = IsKeyDown(KEY_S);
+    input.left = IsKeyDown(KEY_A);
+    input.right = IsKeyDown(KEY_D);
+    input.up = IsKeyDown(KEY_SPACE);
+    input.down = IsKeyDown(KEY_LEFT_SHIFT);
+    input.sprint = IsKeyDown(KEY_LEFT_CONTROL);
+    input.jump = jumpQueued;
+    return input;
 }
 
-// Update camera look direction (shared between modes)
-void UpdateCameraLook(Player* player, float mouseSensitivity) {
-    Vector2 mouseDelta = GetMouseDelta();
-    
-    player->yaw += mouseDelta.x * mouseSensitivity;
-    player->pitch -= mouseDelta.y * mouseSensitivity;
-    
-    // Clamp pitch to prevent camera flip
-    if (player->pitch > 89.0f) player->pitch = 89.0f;
-    if (player->pitch < -89.0f) player->pitch = -89.0f;
+// Update camera from player state, blending the last two physics ticks by alpha (0..1)
+void UpdateCameraFromPlayer(Camera3D* camera, const Player* player, float alpha) {
+    Vector3 forward = GetForwardDirection(player);
+    Vector3 eye = Vector3Lerp(player->previousPosition, player->position, alpha);
+    camera->position = eye;
+    camera->target = Vector3Add(eye, forward);
 }
 
-// Get forward direction from player angles
-Vector3 GetForwardDirection(const Player* player) {
-    Vector3 forward;
-    forward.x = cosf(DEG2RAD * player->yaw) * cosf(DEG2RAD * player->pitch);
-    forward.y = sinf(DEG2RAD * player->pitch);
-    forward.z = sinf(DEG2RAD * player->yaw) * cosf(DEG2RAD * player->pitch);
-    return Vector3Normalize(forward);
-}
+// One frame of input, sampled on the main thread and handed to the simulation
+// (raylib input is only polled and read on the main thread)
+struct GameInput {
+    PlayerInput keys;       // Held keys; jump = Space pressed this frame
+    Vector2 mouseDelta;
+    float frameTime;
+    bool paused;            // Settings menu open: player and physics are frozen
+    bool toggleNoclip;      // V
+    bool cycleBroadphase;   // F4
+    bool toggleRecording;   // F5
+    float mouseSensitivity;
+    float moveSpeed;
+    float fov;
+    float aspect;           // Render width / height, for the frustum
+    int physicsRate;
+};
 
-// Get flat forward direction (for walking - ignores pitch)
-Vector3 GetFlatForwardDirection(const Player* player) {
-    Vector3 forward;
-    forward.x = cosf(DEG2RAD * player->yaw);
-    forward.y = 0.0f;
-    forward.z = sinf(DEG2RAD * player->yaw);
-    return Vector3Normalize(forward);
-}
+// State owned by the simulation thread
+struct GameSim {
+    Player player;
+    Camera3D camera;
+    CollisionWorld* world;
+    float physicsAccumulator;   // Fixed timestep: frame time accumulates and is consumed in whole ticks
+    bool jumpQueued;            // Key presses are latched until a physics tick can consume them
+    InputScript recording;      // F5 records walking input for the headless bench (PhysicsBench --script)
+    bool isRecording;
+    Vector2 recordedLook;
+    int collisionChecks;        // Boxes tested by all physics ticks of the last step
+    int physicsSteps;           // Physics ticks run in the last step
+    float pickTime;             // Crosshair raycast, microseconds (smoothed)
+};
 
-// Noclip camera controller (flying mode)
-void UpdateNoclipMode(Player* player, float moveSpeed, float mouseSensitivity) {
-    float deltaTime = GetFrameTime();
-    
-    UpdateCameraLook(player, mouseSensitivity);
-    
-    Vector3 forward = GetForwardDirection(player);
-    Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, {0, 1, 0}));
-    Vector3 up = { 0.0f, 1.0f, 0.0f };
-    
-    Vector3 moveDir = { 0.0f, 0.0f, 0.0f };
-    
-    if (IsKeyDown(KEY_W)) moveDir = Vector3Add(moveDir, forward);
-    if (IsKeyDown(KEY_S)) moveDir = Vector3Subtract(moveDir, forward);
-    if (IsKeyDown(KEY_A)) moveDir = Vector3Subtract(moveDir, right);
-    if (IsKeyDown(KEY_D)) moveDir = Vector3Add(moveDir, right);
-    if (IsKeyDown(KEY_SPACE)) moveDir = Vector3Add(moveDir, up);
-    if (IsKeyDown(KEY_LEFT_SHIFT)) moveDir = Vector3Subtract(moveDir, up);
-    
-    float currentSpeed = moveSpeed;
-    if (IsKeyDown(KEY_LEFT_CONTROL)) currentSpeed *= 2.5f;
-    
-    if (Vector3Length(moveDir) > 0.0f) {
-        moveDir = Vector3Normalize(moveDir);
-        moveDir = Vector3Scale(moveDir, currentSpeed * deltaTime);
-    }
-    
-    player->position = Vector3Add(player->position, moveDir);
-    player->velocity = { 0, 0, 0 };
-    player->isGrounded = false;
-}
+// Everything the draw stage reads from one simulation step
+struct GameFrame {
+    Camera3D camera;
+    Frustum frustum;
+    BVHHit pick;
+    Player player;              // Copy for the HUD
+    int broadphase;
+    int collisionChecks;
+    int physicsSteps;
+    float pickTime;
+    bool isRecording;
+    int recordedTicks;
+};
 
-// Walking mode with gravity and collision
-void UpdateWalkingMode(Player* player, float moveSpeed, float mouseSensitivity, 
-                       const std::vector<CollisionBox>& colliders) {
-    float deltaTime = GetFrameTime();
-    
-    UpdateCameraLook(player, mouseSensitivity);
-    
-    Vector3 forward = GetFlatForwardDirection(player);
-    Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, {0, 1, 0}));
-    
-    // Horizontal movement input
-    Vector3 moveDir = { 0.0f, 0.0f, 0.0f };
-    
-    if (IsKeyDown(KEY_W)) moveDir = Vector3Add(moveDir, forward);
-    if (IsKeyDown(KEY_S)) moveDir = Vector3Subtract(moveDir, forward);
-    if (IsKeyDown(KEY_A)) moveDir = Vector3Subtract(moveDir, right);
-    if (IsKeyDown(KEY_D)) moveDir = Vector3Add(moveDir, right);
-    
-    float currentSpeed = moveSpeed;
-    if (IsKeyDown(KEY_LEFT_CONTROL)) currentSpeed *= 2.0f;
-    
-    if (Vector3Length(moveDir) > 0.0f) {
-        moveDir = Vector3Normalize(moveDir);
-    }
-    
-    // Apply horizontal velocity
-    player->velocity.x = moveDir.x * currentSpeed;
-    player->velocity.z = moveDir.z * currentSpeed;
-    
-    // Apply gravity
-    if (!player->isGrounded) {
-        player->velocity.y -= GRAVITY * deltaTime;
-    }
-    
-    // Jump
-    if (IsKeyPressed(KEY_SPACE) && player->isGrounded) {
-        player->velocity.y = JUMP_FORCE;
-        player->isGrounded = false;
+// Advance the simulation by one frame of input and fill frame for drawing.
+// Runs on the simulation thread; the world is only read, apart from its broadphase choice.
+void SimulateGame(GameSim& sim, const GameInput& input, GameFrame& frame) {
+    CollisionWorld& world = *sim.world;
+    
+    // F4 cycles the collision broadphase: BVH -> grid -> none (for comparison)
+    if (input.cycleBroadphase) {
+        if (world.broadphase == BROADPHASE_BVH) world.broadphase = BROADPHASE_GRID;
+        else if (world.broadphase == BROADPHASE_GRID) world.broadphase = BROADPHASE_NONE;
+        else world.broadphase = BROADPHASE_BVH;
     }
     
-    // Calculate new position
-    Vector3 newPos = player->position;
-    newPos.x += player->velocity.x * deltaTime;
-    newPos.z += player->velocity.z * deltaTime;
-    
-    // Check horizontal collisions (only if not standing on top of the box)
-    for (const auto& box : colliders) {
-        if (ShouldApplyHorizontalCollision(newPos, player->radius, player->height, box)) {
-            newPos = ResolveCollision(newPos, player->radius, player->height, box);
+    // F5 starts/stops recording input (saved when stopped). Scripts replay through the
+    // walking controller, so recording is refused in noclip.
+    if (input.toggleRecording) {
+        if (sim.isRecording) {
+            sim.recording.Save("input_recording.txt");
+            sim.isRecording = false;
+        } else if (sim.player.noclipMode) {
+            TraceLog(LOG_WARNING, "INPUT: Recording needs walking mode (V to leave noclip)");
+        } else {
+            sim.recording.ticks.clear();
+            sim.recordedLook = { 0.0f, 0.0f };
+            sim.isRecording = true;
         }
     }
     
-    // Apply vertical movement
-    newPos.y += player->velocity.y * deltaTime;
-    
-    // Reset grounded state - will be set true if we find ground below
-    bool foundGround = false;
-    float groundY = GROUND_LEVEL;
-    
-    // Check ground level first
-    if (newPos.y - player->height <= GROUND_LEVEL + 0.05f) {
-        foundGround = true;
-        groundY = GROUND_LEVEL;
-    }
-    
-    // Check if standing on any box
-    for (const auto& box : colliders) {
-        BoundingBox bounds = GetBoxBounds(box);
-        // Check if player is above the box horizontally
-        if (newPos.x + player->radius > bounds.min.x && newPos.x - player->radius < bounds.max.x &&
-            newPos.z + player->radius > bounds.min.z && newPos.z - player->radius < bounds.max.z) {
-            // Check if player's feet are at or below the box top (with small tolerance)
-            float feetY = newPos.y - player->height;
-            if (feetY <= bounds.max.y + 0.05f && feetY >= bounds.max.y - 0.5f) {
-                // Only count as ground if we're falling or stationary vertically
-                if (player->velocity.y <= 0.01f) {
-                    if (bounds.max.y > groundY) {
-                        groundY = bounds.max.y;
-                    }
-                    foundGround = true;
-                }
+    // Only update game if not in menu
+    if (!input.paused) {
+        Player& player = sim.player;
+        
+        // Toggle noclip with V key
+        if (input.toggleNoclip) {
+            player.noclipMode = !player.noclipMode;
+            if (!player.noclipMode) {
+                // Reset vertical velocity when exiting noclip
+                player.velocity.y = 0;
+            } else if (sim.isRecording) {
+                // Noclip ticks would replay as walking; keep what was recorded so far
+                sim.recording.Save("input_recording.txt");
+                sim.isRecording = false;
             }
         }
+        
+        // Mouse look follows the render rate so it never lags behind the cursor
+        UpdateCameraLook(&player, input.mouseDelta, input.mouseSensitivity);
+        sim.recordedLook = Vector2Add(sim.recordedLook, Vector2Scale(input.mouseDelta, input.mouseSensitivity));
+        
+        if (input.keys.jump) sim.jumpQueued = true;
+        
+        // Run as many fixed physics ticks as the elapsed time covers
+        float step = 1.0f / (float)input.physicsRate;
+        sim.physicsAccumulator += fminf(input.frameTime, MAX_FRAME_TIME);
+        sim.collisionChecks = 0;
+        sim.physicsSteps = 0;
+        
+        sim.recording.physicsRate = input.physicsRate;
+        
+        while (sim.physicsAccumulator >= step) {
+            player.previousPosition = player.position;
+            PlayerInput tick = input.keys;
+            tick.jump = sim.jumpQueued;
+            
+            // Update player based on mode
+            if (player.noclipMode) {
+                UpdateNoclipMode(&player, tick, input.moveSpeed * 1.5f, step);
+            } else {
+                sim.collisionChecks += UpdateWalkingMode(&player, tick, input.moveSpeed, world, step);
+            }
+            sim.jumpQueued = false;
+            
+            // Look was already applied this frame; credit it to the first tick only
+            if (sim.isRecording) {
+                tick.look = sim.recordedLook;
+                sim.recordedLook = { 0.0f, 0.0f };
+                sim.recording.ticks.push_back(tick);
+            }
+            
+            sim.physicsAccumulator -= step;
+            sim.physicsSteps++;
+        }
+        
+        // Update camera from player, interpolated between the last two ticks
+        UpdateCameraFromPlayer(&sim.camera, &player, sim.physicsAccumulator / step);
     }
     
-    // Apply ground detection
-    if (foundGround && player->velocity.y <= 0.01f) {
-        newPos.y = groundY + player->height;
-        player->velocity.y = 0;
-        player->isGrounded = true;
-    } else {
-        player->isGrounded = false;
-    }
-    
-    player->position = newPos;
+    // Crosshair pick against the level BVH, timed for the debug overlay
+    double pickStart = GetTime();
+    frame.pick = PickFromView(&sim.player, sim.camera.position, world);
+    float pickMicros = (float)((GetTime() - pickStart) * 1000000.0);
+    sim.pickTime = (sim.pickTime > 0.0f) ? sim.pickTime * 0.95f + pickMicros * 0.05f : pickMicros;
+    
+    // Always update camera FOV (so it updates in real-time from menu)
+    sim.camera.fovy = input.fov;
+    
+    frame.camera = sim.camera;
+    // View frustum for this frame's camera, matching what BeginMode3D sets up
+    frame.frustum = GetCameraFrustum(sim.camera, input.aspect);
+    frame.player = sim.player;
+    frame.broadphase = world.broadphase;
+    frame.collisionChecks = sim.collisionChecks;
+    frame.physicsSteps = sim.physicsSteps;
+    frame.pickTime = sim.pickTime;
+    frame.isRecording = sim.isRecording;
+    frame.recordedTicks = (int)sim.recording.ticks.size();
 }
 
-// Update camera from player state
-void UpdateCameraFromPlayer(Camera3D* camera, const Player* player) {
-    Vector3 forward = GetForwardDirection(player);
-    camera->position = player->position;
-    camera->target = Vector3Add(player->position, forward);
-}
-
-int main()
+int main(int argc, char** argv)
 {
+    // Optional stress scene: --boxes N scatters N extra boxes around the level
+    int extraBoxes = 0;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--boxes") == 0) extraBoxes = atoi(argv[++i]);
+    }
+    
     // Window configuration
     const int screenWidth = 1280;
     const int screenHeight = 720;
@@ -433,6 +375,7 @@ int main()
     settings.windowMode = WINDOW_MODE_WINDOWED;
     settings.defaultWidth = screenWidth;
     settings.defaultHeight = screenHeight;
+    settings.physicsRate = 60;
     
     SetTargetFPS(settings.targetFPS);
     
@@ -442,55 +385,71 @@ int main()
     
     // Debug overlay state
     bool showDebugOverlay = false;
+    bool frustumCulling = true;
+    bool bakedBoxes = false;     // F7: static batch instead of instancing
     PerformanceStats perfStats = {};
     
     // Lock and hide cursor for FPS controls
     DisableCursor();
-
+    
+    // Player, camera and physics state, advanced by SimulateGame on the simulation thread
+    GameSim sim = {};
+    
     // Player setup
-    Player player;
-    player.position = { 0.0f, 1.8f, 10.0f };
-    player.velocity = { 0.0f, 0.0f, 0.0f };
-    player.yaw = -90.0f;
-    player.pitch = 0.0f;
-    player.height = 1.8f;
-    player.radius = 0.3f;
-    player.isGrounded = false;
-    player.noclipMode = false;
-
+    sim.player = CreatePlayer({ 0.0f, 1.8f, 10.0f }, -90.0f);
+    
     // Camera setup (first-person perspective)
-    Camera3D camera = { 0 };
-    camera.position = player.position;
-    camera.target = { 0.0f, 1.8f, 0.0f };
-    camera.up = { 0.0f, 1.0f, 0.0f };
-    camera.fovy = settings.fov;
-    camera.projection = CAMERA_PERSPECTIVE;
-
+    sim.camera.position = sim.player.position;
+    sim.camera.target = { 0.0f, 1.8f, 0.0f };
+    sim.camera.up = { 0.0f, 1.0f, 0.0f };
+    sim.camera.fovy = settings.fov;
+    sim.camera.projection = CAMERA_PERSPECTIVE;
+    
     // Create collision boxes for the scene
-    std::vector<CollisionBox> colliders;
-    
-    // Main center cube
-    CollisionBox centerCube;
-    centerCube.position = { 0.0f, 1.0f, 0.0f };
-    centerCube.size = { 2.0f, 2.0f, 2.0f };
-    centerCube.color = RED;
-    centerCube.wireColor = MAROON;
-    colliders.push_back(centerCube);
-    
-    // Pillars
-    for (int i = -5; i <= 5; i += 2) {
-        for (int j = -5; j <= 5; j += 2) {
-            if (i == 0 && j == 0) continue;
-            float height = 1.0f + (float)(abs(i + j) % 3);
-            CollisionBox pillar;
-            pillar.position = { (float)i * 3.0f, height / 2.0f, (float)j * 3.0f };
-            pillar.size = { 0.5f, height, 0.5f };
-            pillar.color = BLUE;
-            pillar.wireColor = DARKBLUE;
-            colliders.push_back(pillar);
-        }
+    CollisionWorld world;
+    std::vector<CollisionBox>& colliders = world.boxes;
+    
+    BuildDemoLevel(colliders);
+    if (extraBoxes > 0) {
+        AddBoxField(colliders, extraBoxes, sqrtf((float)extraBoxes) * 2.0f, 1);
     }
     
+    // Broadphase grid + BVH over the static colliders (rebuild if colliders change)
+    world.Build();
+    sim.world = &world;
+    
+    // All boxes render as instances of one cube; the instance buffer follows world.Build()
+    BoxRenderer boxRenderer;
+    boxRenderer.Load();
+    
+    // Alternative path: boxes baked into a few static meshes (built on first use)
+    StaticBatch staticBatch;
+    
+    // Ground grid and plane are uploaded once instead of rebuilt through rlgl every frame
+    GridMesh groundGrid;
+    groundGrid.Load(GROUND_GRID_SLICES, GROUND_GRID_SPACING);
+    Model groundPlane = LoadModelFromMesh(GenMeshPlane(GROUND_PLANE_SIZE, GROUND_PLANE_SIZE, 1, 1));
+    groundPlane.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = DARKGREEN;
+    
+    // HUD panels are drawn into textures and only redrawn when their contents change
+    HudPanel helpPanel, statusPanel, debugPanel;
+    helpPanel.Load(340, 175, 0.0f);
+    statusPanel.Load(280, 50, HUD_REFRESH_INTERVAL);
+    debugPanel.Load(320, 484, HUD_REFRESH_INTERVAL);
+    
+    // Frame time graph: a minute of history on the GPU, drawn live over the debug panel
+    FrameGraph frameGraph;
+    frameGraph.Load();
+    Rectangle frameGraphRect = { 0 };   // Graph area inside debugPanel, set when the panel redraws
+    
+    // The simulation runs on its own thread one frame ahead of drawing (F9 switches to
+    // serial for comparison). Input is copied to simInput while the thread is idle and
+    // each step fills one of the frame slots.
+    GameInput simInput = {};
+    GameFrame frames[FRAME_PIPELINE_SLOTS] = {};
+    FramePipeline pipeline;
+    pipeline.Start([&](int slot) { SimulateGame(sim, simInput, frames[slot]); });
+    
     // Game loop
     while (!WindowShouldClose())
     {
@@ -498,12 +457,33 @@ int main()
         
         // Update performance stats every frame
         perfStats.Update();
+        frameGraph.Push(perfStats.currentFrameTime);
         
         // F3 toggles debug overlay
         if (IsKeyPressed(KEY_F3)) {
             showDebugOverlay = !showDebugOverlay;
         }
         
+        // F6 toggles frustum culling of the collision boxes (for comparison)
+        if (IsKeyPressed(KEY_F6)) {
+            frustumCulling = !frustumCulling;
+        }
+        
+        // F7 switches box drawing between instancing and the baked static batch
+        if (IsKeyPressed(KEY_F7)) {
+            bakedBoxes = !bakedBoxes;
+        }
+        
+        // F8 switches instanced box edges between the outline shader and a separate line pass
+        if (IsKeyPressed(KEY_F8)) {
+            boxRenderer.shaderOutlines = !boxRenderer.shaderOutlines;
+        }
+        
+        // F9 switches between the pipelined simulation thread and running it inline
+        if (IsKeyPressed(KEY_F9)) {
+            pipeline.threaded = !pipeline.threaded;
+        }
+        
         // Track window mode and apply when changed
         static int appliedWindowMode = WINDOW_MODE_WINDOWED;
         
@@ -534,57 +514,67 @@ int main()
             }
         }
         
-        // Only update game if not in menu
-        if (!showSettingsMenu) {
-            // Toggle noclip with V key
-            if (IsKeyPressed(KEY_V)) {
-                player.noclipMode = !player.noclipMode;
-                if (!player.noclipMode) {
-                    // Reset vertical velocity when exiting noclip
-                    player.velocity.y = 0;
-                }
-            }
-            
-            // Update player based on mode
-            if (player.noclipMode) {
-                UpdateNoclipMode(&player, settings.moveSpeed * 1.5f, settings.mouseSensitivity);
-            } else {
-                UpdateWalkingMode(&player, settings.moveSpeed, settings.mouseSensitivity, colliders);
-            }
-            
-            // Update camera from player
-            UpdateCameraFromPlayer(&camera, &player);
-            
-            // Toggle cursor lock with Tab
-            if (IsKeyPressed(KEY_TAB)) {
-                if (IsCursorHidden()) EnableCursor();
-                else DisableCursor();
-            }
+        // Toggle cursor lock with Tab
+        if (!showSettingsMenu && IsKeyPressed(KEY_TAB)) {
+            if (IsCursorHidden()) EnableCursor();
+            else DisableCursor();
         }
         
-        // Always update camera FOV (so it updates in real-time from menu)
-        camera.fovy = settings.fov;
-        
         // Get current render size (works correctly in all window modes including fullscreen)
         int currentWidth = GetRenderWidth();
         int currentHeight = GetRenderHeight();
-
+        
+        // --- SIMULATE ---
+        // This frame's input goes to the simulation; the frame drawn below is the one it
+        // finished from the previous frame's input (or this one's, when serial)
+        GameInput input = {};
+        if (!showSettingsMenu) {
+            input.keys = SampleInput(IsKeyPressed(KEY_SPACE));
+            input.mouseDelta = GetMouseDelta();
+            input.toggleNoclip = IsKeyPressed(KEY_V);
+        }
+        input.frameTime = GetFrameTime();
+        input.paused = showSettingsMenu;
+        input.cycleBroadphase = IsKeyPressed(KEY_F4);
+        input.toggleRecording = IsKeyPressed(KEY_F5);
+        input.mouseSensitivity = settings.mouseSensitivity;
+        input.moveSpeed = settings.moveSpeed;
+        input.fov = settings.fov;
+        input.aspect = (float)currentWidth / (float)currentHeight;
+        input.physicsRate = settings.physicsRate;
+        
+        const GameFrame& frame = frames[pipeline.Advance([&] { simInput = input; })];
+        const Player& player = frame.player;
+        const BVHHit& pick = frame.pick;
+        double submitStart = GetTime();
+        
         // --- DRAW ---
         BeginDrawing();
             ClearBackground(DARKGRAY);
             
-            BeginMode3D(camera);
+            BeginMode3D(frame.camera);
                 
                 // Draw ground plane (grid)
-                DrawGrid(50, 1.0f);
+                groundGrid.Draw();
                 
                 // Draw ground plane (solid)
-                DrawPlane({ 0.0f, 0.0f, 0.0f }, { 50.0f, 50.0f }, DARKGREEN);
+                DrawModel(groundPlane, { 0.0f, 0.0f, 0.0f }, 1.0f, WHITE);
                 
-                // Draw all collision boxes
-                for (const auto& box : colliders) {
-                    DrawCube(box.position, box.size.x, box.size.y, box.size.z, box.color);
-                    DrawCubeWires(box.position, box.size.x, box.size.y, box.size.z, box.wireColor);
+                // Draw collision boxes in view (instanced or baked)
+                const Frustum* boxFrustum = frustumCulling ? &frame.frustum : nullptr;
+                if (bakedBoxes) {
+                    staticBatch.Sync(world);
+                    perfStats.drawCalls = staticBatch.Draw(world, boxFrustum);
+                } else {
+                    boxRenderer.Sync(world);
+                    perfStats.drawCalls = boxRenderer.Draw(world, boxFrustum);
+                }
+                
+                // Highlight the box under the crosshair
+                if (pick.index >= 0) {
+                    const CollisionBox& picked = colliders[pick.index];
+                    DrawCubeWires(picked.position, picked.size.x + 0.05f, picked.size.y + 0.05f,
+                                  picked.size.z + 0.05f, YELLOW);
                 }
                 
                 // Draw coordinate axes for reference
@@ -598,46 +588,64 @@ int main()
             DrawLine(currentWidth/2 - 10, currentHeight/2, currentWidth/2 + 10, currentHeight/2, WHITE);
             DrawLine(currentWidth/2, currentHeight/2 - 10, currentWidth/2, currentHeight/2 + 10, WHITE);
             
-            // Draw HUD / instructions
-            DrawRectangle(10, 10, 340, 175, Fade(BLACK, 0.5f));
-            
-            // Mode indicator
-            if (player.noclipMode) {
-                DrawText("MODE: NOCLIP (Flying)", 20, 20, 18, YELLOW);
-                DrawText("WASD - Fly horizontally", 20, 45, 16, LIGHTGRAY);
-                DrawText("Space/Shift - Fly up/down", 20, 65, 16, LIGHTGRAY);
-            } else {
-                DrawText("MODE: WALKING", 20, 20, 18, GREEN);
-                DrawText("WASD - Walk", 20, 45, 16, LIGHTGRAY);
-                DrawText("Space - Jump", 20, 65, 16, LIGHTGRAY);
+            // Draw HUD / instructions (only changes with the movement mode)
+            if (helpPanel.BeginRefresh(player.noclipMode ? 1 : 0, GetTime())) {
+                DrawRectangle(0, 0, 340, 175, Fade(BLACK, 0.5f));
+                
+                // Mode indicator
+                if (player.noclipMode) {
+                    DrawText("MODE: NOCLIP (Flying)", 10, 10, 18, YELLOW);
+                    DrawText("WASD - Fly horizontally", 10, 35, 16, LIGHTGRAY);
+                    DrawText("Space/Shift - Fly up/down", 10, 55, 16, LIGHTGRAY);
+                } else {
+                    DrawText("MODE: WALKING", 10, 10, 18, GREEN);
+                    DrawText("WASD - Walk", 10, 35, 16, LIGHTGRAY);
+                    DrawText("Space - Jump", 10, 55, 16, LIGHTGRAY);
+                }
+                
+                DrawText("Mouse - Look around", 10, 75, 16, LIGHTGRAY);
+                DrawText("Ctrl - Sprint", 10, 95, 16, LIGHTGRAY);
+                DrawText("V - Toggle noclip", 10, 115, 16, ORANGE);
+                DrawText("Tab - Toggle mouse lock", 10, 135, 16, LIGHTGRAY);
+                DrawText("ESC - Settings | F3 - Debug", 10, 155, 16, YELLOW);
+                helpPanel.EndRefresh();
             }
+            helpPanel.Draw(10, 10);
             
-            DrawText("Mouse - Look around", 20, 85, 16, LIGHTGRAY);
-            DrawText("Ctrl - Sprint", 20, 105, 16, LIGHTGRAY);
-            DrawText("V - Toggle noclip", 20, 125, 16, ORANGE);
-            DrawText("Tab - Toggle mouse lock", 20, 145, 16, LIGHTGRAY);
-            DrawText("ESC - Settings | F3 - Debug", 20, 165, 16, YELLOW);
-            
-            // Player status
-            DrawRectangle(10, currentHeight - 60, 280, 50, Fade(BLACK, 0.5f));
-            DrawText(TextFormat("Position: (%.1f, %.1f, %.1f)", 
-                     player.position.x, player.position.y, player.position.z), 
-                     20, currentHeight - 50, 16, WHITE);
-            DrawText(TextFormat("Grounded: %s | Vel Y: %.1f", 
-                     player.isGrounded ? "Yes" : "No", player.velocity.y),
-                     20, currentHeight - 30, 16, LIGHTGRAY);
+            // Player status (numeric, refreshed at HUD_REFRESH_INTERVAL)
+            if (statusPanel.BeginRefresh(0, GetTime())) {
+                DrawRectangle(0, 0, 280, 50, Fade(BLACK, 0.5f));
+                DrawText(TextFormat("Position: (%.1f, %.1f, %.1f)", 
+                         player.position.x, player.position.y, player.position.z), 
+                         10, 10, 16, WHITE);
+                DrawText(TextFormat("Grounded: %s | Vel Y: %.1f", 
+                         player.isGrounded ? "Yes" : "No", player.velocity.y),
+                         10, 30, 16, LIGHTGRAY);
+                statusPanel.EndRefresh();
+            }
+            statusPanel.Draw(10, currentHeight - 60);
             
             if (settings.showFPS) DrawFPS(currentWidth - 100, 10);
             
+            // Input recording indicator (F5)
+            if (frame.isRecording) {
+                DrawText(TextFormat("REC %d ticks (F5 to save)", frame.recordedTicks),
+                         currentWidth - 260, 35, 16, RED);
+            }
+            
             // --- DEBUG OVERLAY (F3) ---
-            if (showDebugOverlay) {
-                int debugX = currentWidth - 320;
-                int debugY = 40;
+            // Redrawn at HUD_REFRESH_INTERVAL, or at once when a toggle it reports changes
+            unsigned int debugKey = (frustumCulling ? 1u : 0u) | (bakedBoxes ? 2u : 0u) |
+                                    (boxRenderer.shaderOutlines ? 4u : 0u) | (player.noclipMode ? 8u : 0u) |
+                                    ((unsigned int)frame.broadphase << 4) | (pipeline.threaded ? 64u : 0u);
+            if (showDebugOverlay && debugPanel.BeginRefresh(debugKey, GetTime())) {
+                int debugX = 10;
+                int debugY = 10;
                 int lineHeight = 18;
                 
                 // Background panel
-                DrawRectangle(debugX - 10, debugY - 10, 320, 340, Fade(BLACK, 0.8f));
-                DrawRectangleLines(debugX - 10, debugY - 10, 320, 340, LIME);
+                DrawRectangle(0, 0, 320, 484, Fade(BLACK, 0.8f));
+                DrawRectangleLines(0, 0, 320, 484, LIME);
                 
                 // Title
                 DrawText("DEBUG / PERFORMANCE", debugX, debugY, 18, LIME);
@@ -667,39 +675,15 @@ int main()
                          debugX, debugY, 14, RED);
                 debugY += lineHeight + 5;
                 
-                // Frame time graph
-                DrawText("Frame Time Graph (last 120 frames):", debugX, debugY, 14, YELLOW);
+                // Frame time graph: background only, the bars are drawn live after the panel
+                DrawText(TextFormat("Frame Time Graph (last %d frames):", FRAME_GRAPH_CAPACITY), debugX, debugY, 14, YELLOW);
                 debugY += lineHeight;
                 
                 int graphWidth = 280;
                 int graphHeight = 50;
                 DrawRectangle(debugX, debugY, graphWidth, graphHeight, Fade(DARKGRAY, 0.5f));
                 DrawRectangleLines(debugX, debugY, graphWidth, graphHeight, GRAY);
-                
-                // Draw graph bars
-                if (!perfStats.frameTimeHistory.empty()) {
-                    int barCount = (int)perfStats.frameTimeHistory.size();
-                    float barWidth = (float)graphWidth / PerformanceStats::HISTORY_SIZE;
-                    float maxDisplayTime = 33.33f;  // Cap at ~30fps for visual scale
-                    
-                    for (int i = 0; i < barCount; i++) {
-                        float ft = perfStats.frameTimeHistory[i];
-                        float normalizedHeight = (ft / maxDisplayTime) * graphHeight;
-                        if (normalizedHeight > graphHeight) normalizedHeight = graphHeight;
-                        
-                        Color barColor = GREEN;
-                        if (ft > 16.67f) barColor = YELLOW;  // Below 60fps
-                        if (ft > 33.33f) barColor = RED;     // Below 30fps
-                        
-                        DrawRectangle(
-                            debugX + (int)(i * barWidth),
-                            debugY + graphHeight - (int)normalizedHeight,
-                            (int)barWidth + 1,
-                            (int)normalizedHeight,
-                            barColor
-                        );
-                    }
-                }
+                frameGraphRect = { (float)debugX + 1, (float)debugY + 1, (float)graphWidth - 2, (float)graphHeight - 2 };
                 debugY += graphHeight + 10;
                 
                 // Player info section
@@ -740,9 +724,79 @@ int main()
                          debugX, debugY, 14, WHITE);
                 debugY += lineHeight;
                 
+                if (bakedBoxes) {
+                    DrawText(TextFormat("Boxes (F7): baked, %d chunks, %d draw calls", (int)staticBatch.chunks.size(),
+                             perfStats.drawCalls), debugX, debugY, 14, WHITE);
+                    debugY += lineHeight;
+                    
+                    DrawText(TextFormat("Culling (F6): %s, %d / %d chunks visible", frustumCulling ? "on" : "off",
+                             staticBatch.visibleChunks, (int)staticBatch.chunks.size()),
+                             debugX, debugY, 14, frustumCulling ? WHITE : ORANGE);
+                } else {
+                    DrawText(TextFormat("Boxes (F7): %s, %s (F8), %d draws", boxRenderer.ready ? "instanced" : "immediate",
+                             boxRenderer.shaderOutlines ? "outline shader" : "line pass", perfStats.drawCalls),
+                             debugX, debugY, 14, boxRenderer.ready ? WHITE : ORANGE);
+                    debugY += lineHeight;
+                    
+                    DrawText(TextFormat("Culling (F6): %s, %d visible / %d culled",
+                             frustumCulling ? "on" : "off", boxRenderer.visibleCount,
+                             (int)colliders.size() - boxRenderer.visibleCount),
+                             debugX, debugY, 14, frustumCulling ? WHITE : ORANGE);
+                }
+                debugY += lineHeight;
+                
+                DrawText(TextFormat("Physics: %d Hz, %d steps this frame", 
+                         settings.physicsRate, frame.physicsSteps), 
+                         debugX, debugY, 14, WHITE);
+                debugY += lineHeight;
+                
+                DrawText(TextFormat("Collision: %d tested / %d boxes", 
+                         frame.collisionChecks, (int)colliders.size()), 
+                         debugX, debugY, 14, WHITE);
+                debugY += lineHeight;
+                
+                if (pick.index >= 0) {
+                    DrawText(TextFormat("Pick: #%d %.1fm n(%.0f,%.0f,%.0f) %.2f us", pick.index,
+                             pick.distance, pick.normal.x, pick.normal.y, pick.normal.z, frame.pickTime),
+                             debugX, debugY, 14, WHITE);
+                } else {
+                    DrawText(TextFormat("Pick: none within %.0fm, %.2f us", PICK_MAX_DISTANCE, frame.pickTime),
+                             debugX, debugY, 14, GRAY);
+                }
+                debugY += lineHeight;
+                
+                const ContactCache& contacts = player.contacts;
+                DrawText(TextFormat("Contacts: %d cached, %s%s", contacts.nearby.count,
+                         player.isGrounded ? "grounded" : "airborne",
+                         contacts.sleeping ? ", sleeping" : ""),
+                         debugX, debugY, 14, contacts.sleeping ? GREEN : WHITE);
+                debugY += lineHeight;
+                
+                if (frame.broadphase == BROADPHASE_BVH) {
+                    DrawText(TextFormat("Broadphase (F4): BVH, %d nodes", (int)world.bvh.nodes.size()), 
+                             debugX, debugY, 14, WHITE);
+                } else if (frame.broadphase == BROADPHASE_GRID) {
+                    DrawText(TextFormat("Broadphase (F4): Grid %dx%d", world.grid.cellsX, world.grid.cellsZ), 
+                             debugX, debugY, 14, WHITE);
+                } else {
+                    DrawText(TextFormat("Broadphase (F4): None, SIMD x%d", COLLIDER_SIMD_WIDTH), 
+                             debugX, debugY, 14, ORANGE);
+                }
+                debugY += lineHeight;
+                
+                DrawText(TextFormat("Threads (F9): %s, sim %.2f ms, submit %.2f ms", pipeline.threaded ? "pipelined" : "serial",
+                         pipeline.simMs, perfStats.submitTime), debugX, debugY, 14, pipeline.threaded ? WHITE : ORANGE);
+                debugY += lineHeight;
+                
                 DrawText(TextFormat("Total Frames: %d  Time: %.1fs", 
                          perfStats.frameCount, perfStats.totalTime), 
                          debugX, debugY, 14, GRAY);
+                debugPanel.EndRefresh();
+            }
+            if (showDebugOverlay) {
+                debugPanel.Draw(currentWidth - 330, 30);
+                frameGraph.Draw({ currentWidth - 330 + frameGraphRect.x, 30 + frameGraphRect.y,
+                                  frameGraphRect.width, frameGraphRect.height });
             }
             
             // --- SETTINGS MENU ---
@@ -752,7 +806,7 @@ int main()
                 
                 // Menu panel
                 int panelWidth = 400;
-                int panelHeight = 570;
+                int panelHeight = 620;
                 int panelX = (currentWidth - panelWidth) / 2;
                 int panelY = (currentHeight - panelHeight) / 2;
                 
@@ -810,6 +864,16 @@ int main()
                 GuiSlider({ (float)controlX, (float)yPos, (float)controlWidth, 20 }, NULL, NULL, &settings.moveSpeed, 1.0f, 20.0f);
                 yPos += spacing;
                 
+                // Physics tick rate (independent of render FPS)
+                DrawText("Physics Rate (Hz):", controlX, yPos, 16, LIGHTGRAY);
+                DrawText(TextFormat("%d", settings.physicsRate), controlX + controlWidth - 40, yPos, 16, WHITE);
+                yPos += 22;
+                float physicsRateValue = (float)settings.physicsRate;
+                GuiSlider({ (float)controlX, (float)yPos, (float)controlWidth, 20 }, NULL, NULL, &physicsRateValue,
+                          (float)MIN_PHYSICS_RATE, (float)MAX_PHYSICS_RATE);
+                settings.physicsRate = (int)physicsRateValue;
+                yPos += spacing;
+                
                 // Show FPS Toggle
                 GuiCheckBox({ (float)controlX, (float)yPos, 20, 20 }, "Show FPS Counter", &settings.showFPS);
                 yPos += 40;
@@ -830,6 +894,13 @@ int main()
                     }
                     // Exit Game button
                     if (GuiButton({ (float)controlX, (float)(panelY + panelHeight - 60), (float)controlWidth, 40 }, "Exit Game")) {
+                        pipeline.Stop();
+                        boxRenderer.Unload();
+                        staticBatch.Unload();
+                        groundGrid.Unload();
+                        UnloadModel(groundPlane);
+                        helpPanel.Unload(); statusPanel.Unload(); debugPanel.Unload();
+                        frameGraph.Unload();
                         CloseWindow();
                         return 0;
                     }
@@ -858,9 +929,17 @@ int main()
                 }
             }
             
+            perfStats.submitTime = (float)((GetTime() - submitStart) * 1000.0);
         EndDrawing();
     }
-
+    
+    pipeline.Stop();
+    boxRenderer.Unload();
+    staticBatch.Unload();
+    groundGrid.Unload();
+    UnloadModel(groundPlane);
+    helpPanel.Unload(); statusPanel.Unload(); debugPanel.Unload();
+    frameGraph.Unload();
     CloseWindow();
     return 0;
 }
@@ -0,0 +1,61 @@
+// mesh_cache.cpp - Generated meshes shared by their generator parameters
+
+#include "mesh_cache.h"
+#include <tuple>
+
+bool MeshKey::operator<(const MeshKey& other) const {
+    return std::tie(shape, size[0], size[1], size[2], segments[0], segments[1]) <
+           std::tie(other.shape, other.size[0], other.size[1], other.size[2], other.segments[0], other.segments[1]);
+}
+
+static Mesh Generate(const MeshKey& key) {
+    const float* s = key.size;
+    const int* n = key.segments;
+    switch (key.shape) {
+        case MESH_SHAPE_CUBE: return GenMeshCube(s[0], s[1], s[2]);
+        case MESH_SHAPE_SPHERE: return GenMeshSphere(s[0], n[0], n[1]);
+        case MESH_SHAPE_CYLINDER: return GenMeshCylinder(s[0], s[1], n[0]);
+        case MESH_SHAPE_CONE: return GenMeshCone(s[0], s[1], n[0]);
+        case MESH_SHAPE_TORUS: return GenMeshTorus(s[0], s[1], n[0], n[1]);
+        case MESH_SHAPE_KNOT: return GenMeshKnot(s[0], s[1], n[0], n[1]);
+    }
+    TraceLog(LOG_WARNING, "MeshCache: unknown shape %d", key.shape);
+    return GenMeshCube(1.0f, 1.0f, 1.0f);
+}
+
+const Mesh& MeshCache::Get(const MeshKey& key) {
+    requests++;
+    auto it = meshes.find(key);
+    if (it != meshes.end()) return it->second;
+    return meshes.emplace(key, Generate(key)).first->second;
+}
+
+void MeshCache::Unload() {
+    for (auto& entry : meshes) UnloadMesh(entry.second);
+    meshes.clear();
+    requests = 0;
+}
+
+const Mesh& MeshCache::Cube(float width, float height, float length) {
+    return Get({ MESH_SHAPE_CUBE, { width, height, length }, { 0, 0 } });
+}
+
+const Mesh& MeshCache::Sphere(float radius, int rings, int slices) {
+    return Get({ MESH_SHAPE_SPHERE, { radius, 0.0f, 0.0f }, { rings, slices } });
+}
+
+const Mesh& MeshCache::Cylinder(float radius, float height, int slices) {
+    return Get({ MESH_SHAPE_CYLINDER, { radius, height, 0.0f }, { slices, 0 } });
+}
+
+const Mesh& MeshCache::Cone(float radius, float height, int slices) {
+    return Get({ MESH_SHAPE_CONE, { radius, height, 0.0f }, { slices, 0 } });
+}
+
+const Mesh& MeshCache::Torus(float radius, float size, int radSeg, int sides) {
+    return Get({ MESH_SHAPE_TORUS, { radius, size, 0.0f }, { radSeg, sides } });
+}
+
+const Mesh& MeshCache::Knot(float radius, float size, int radSeg, int sides) {
+    return Get({ MESH_SHAPE_KNOT, { radius, size, 0.0f }, { radSeg, sides } });
+}
@@ -0,0 +1,39 @@
+// mesh_cache.h - Generated meshes shared by their generator parameters
+#pragma once
+
+#include "raylib.h"
+#include <map>
+
+// Generators the cache knows about
+const int MESH_SHAPE_CUBE = 0;
+const int MESH_SHAPE_SPHERE = 1;
+const int MESH_SHAPE_CYLINDER = 2;
+const int MESH_SHAPE_CONE = 3;
+const int MESH_SHAPE_TORUS = 4;
+const int MESH_SHAPE_KNOT = 5;
+
+// Generator call: shape, float arguments, then segment counts, in GenMesh* argument order
+struct MeshKey {
+    int shape;
+    float size[3];
+    int segments[2];
+    
+    bool operator<(const MeshKey& other) const;
+};
+
+// Every distinct generator call is made and uploaded once; repeated requests return the
+// same GPU mesh. The cache owns the meshes, so callers never unload what they get.
+struct MeshCache {
+    std::map<MeshKey, Mesh> meshes;
+    int requests = 0;               // Get calls, for comparing against meshes.size()
+    
+    const Mesh& Get(const MeshKey& key);
+    void Unload();
+    
+    const Mesh& Cube(float width, float height, float length);
+    const Mesh& Sphere(float radius, int rings, int slices);
+    const Mesh& Cylinder(float radius, float height, int slices);
+    const Mesh& Cone(float radius, float height, int slices);
+    const Mesh& Torus(float radius, float size, int radSeg, int sides);
+    const Mesh& Knot(float radius, float size, int radSeg, int sides);
+};
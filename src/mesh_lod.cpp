@@ -0,0 +1,109 @@
+// mesh_lod.cpp - Distance-based level of detail for generated meshes
+
+#include "mesh_lod.h"
+#include "raymath.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+void LodModel::Add(const Mesh& mesh, float pixels) {
+    if (levelCount == LOD_MAX_LEVELS) return;
+    if (levelCount == 0) {
+        BoundingBox bounds = GetMeshBoundingBox(mesh);
+        radius = Vector3Length(Vector3Max(Vector3Negate(bounds.min), bounds.max));
+    }
+    levels[levelCount] = mesh;
+    minPixels[levelCount] = pixels;
+    levelCount++;
+}
+
+int LodModel::Select(int current, float pixels) const {
+    int level = std::clamp(current, 0, levelCount - 1);
+    while (level < levelCount - 1 && pixels < minPixels[level] * (1.0f - LOD_HYSTERESIS)) level++;
+    while (level > 0 && pixels > minPixels[level - 1] * (1.0f + LOD_HYSTERESIS)) level--;
+    return level;
+}
+
+// Segment counts for each level: `detail` halves per level until it would drop below
+// `minimum`. A level is kept down to the size where the next one's segments are
+// LOD_PIXELS_PER_SEGMENT across.
+static int LevelCount(int detail, int minimum) {
+    int count = 1;
+    while (count < LOD_MAX_LEVELS && (detail >> count) >= minimum) count++;
+    return count;
+}
+
+static float LevelThreshold(int detail, int level, int count) {
+    return level + 1 < count ? (float)(detail >> (level + 1)) * LOD_PIXELS_PER_SEGMENT : 0.0f;
+}
+
+LodModel LoadLodSphere(MeshCache& cache, float radius, int rings, int slices) {
+    LodModel model;
+    int count = LevelCount(slices, 4);
+    for (int level = 0; level < count; level++) {
+        const Mesh& mesh = cache.Sphere(radius, std::max(3, rings >> level), slices >> level);
+        model.Add(mesh, LevelThreshold(slices, level, count));
+    }
+    return model;
+}
+
+LodModel LoadLodCylinder(MeshCache& cache, float radius, float height, int slices) {
+    LodModel model;
+    int count = LevelCount(slices, 4);
+    for (int level = 0; level < count; level++) {
+        model.Add(cache.Cylinder(radius, height, slices >> level), LevelThreshold(slices, level, count));
+    }
+    return model;
+}
+
+LodModel LoadLodCone(MeshCache& cache, float radius, float height, int slices) {
+    LodModel model;
+    int count = LevelCount(slices, 4);
+    for (int level = 0; level < count; level++) {
+        model.Add(cache.Cone(radius, height, slices >> level), LevelThreshold(slices, level, count));
+    }
+    return model;
+}
+
+LodModel LoadLodTorus(MeshCache& cache, float radius, float size, int radSeg, int sides) {
+    LodModel model;
+    int count = LevelCount(radSeg, 4);
+    for (int level = 0; level < count; level++) {
+        const Mesh& mesh = cache.Torus(radius, size, radSeg >> level, std::max(3, sides >> level));
+        model.Add(mesh, LevelThreshold(radSeg, level, count));
+    }
+    return model;
+}
+
+LodModel LoadLodKnot(MeshCache& cache, float radius, float size, int radSeg, int sides) {
+    // The tube winds around the knot several times, so it keeps more segments per pixel
+    LodModel model;
+    int count = LevelCount(radSeg, 16);
+    for (int level = 0; level < count; level++) {
+        const Mesh& mesh = cache.Knot(radius, size, radSeg >> level, std::max(4, sides >> level));
+        model.Add(mesh, LevelThreshold(radSeg, level, count));
+    }
+    return model;
+}
+
+void LodView::Begin(Camera3D camera, int screenHeight, bool lodEnabled) {
+    eye = camera.position;
+    pixelScale = (float)screenHeight / tanf(camera.fovy * 0.5f * DEG2RAD);
+    enabled = lodEnabled;
+    vertices = fullVertices = 0;
+}
+
+const Mesh& LodView::Pick(const LodModel& model, int& level, Vector3 center, float scale) {
+    if (enabled) {
+        // Projected diameter of the bounding sphere: 2r / (2d tan(fovy / 2)) of the screen height
+        float radius = model.radius * scale;
+        float distance = Vector3Distance(eye, center);
+        float pixels = distance > radius ? radius * pixelScale / distance : FLT_MAX;
+        level = model.Select(level, pixels);
+    } else {
+        level = 0;
+    }
+    vertices += model.levels[level].vertexCount;
+    fullVertices += model.levels[0].vertexCount;
+    return model.levels[level];
+}
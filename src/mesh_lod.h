@@ -0,0 +1,45 @@
+// mesh_lod.h - Distance-based level of detail for generated meshes
+#pragma once
+
+#include "raylib.h"
+#include "mesh_cache.h"
+
+const int LOD_MAX_LEVELS = 4;
+const float LOD_PIXELS_PER_SEGMENT = 4.0f;  // Projected diameter one segment of a level may cover
+const float LOD_HYSTERESIS = 0.2f;          // Switch only once 20% past a threshold, to avoid popping
+
+// One logical model as a chain of meshes at decreasing tessellation (level 0 = full detail).
+// Each coarser level halves the segment counts of the one before it. The meshes come from
+// a MeshCache, so models built with the same parameters share them and copies are cheap.
+struct LodModel {
+    Mesh levels[LOD_MAX_LEVELS] = {};
+    float minPixels[LOD_MAX_LEVELS] = {};   // Smallest projected diameter that keeps each level
+    int levelCount = 0;
+    float radius = 0.0f;                    // Contains the mesh at any rotation, at scale 1
+    
+    // Append the next coarser level, kept while the model covers at least minPixels on screen
+    void Add(const Mesh& mesh, float minPixels);
+    
+    // Level for an instance drawn at `current` last frame, now covering `pixels`
+    int Select(int current, float pixels) const;
+};
+
+LodModel LoadLodSphere(MeshCache& cache, float radius, int rings, int slices);
+LodModel LoadLodCylinder(MeshCache& cache, float radius, float height, int slices);
+LodModel LoadLodCone(MeshCache& cache, float radius, float height, int slices);
+LodModel LoadLodTorus(MeshCache& cache, float radius, float size, int radSeg, int sides);
+LodModel LoadLodKnot(MeshCache& cache, float radius, float size, int radSeg, int sides);
+
+// Per-frame level selection for a perspective camera, with counts for the debug overlay
+struct LodView {
+    Vector3 eye = { 0 };
+    float pixelScale = 0.0f;        // Screen height over tan(fovy / 2)
+    bool enabled = true;            // Off: every instance draws level 0
+    int vertices = 0;               // Vertices submitted through Pick this frame
+    int fullVertices = 0;           // Vertices the same draws cost at level 0
+    
+    void Begin(Camera3D camera, int screenHeight, bool lodEnabled);
+    
+    // Mesh to draw for an instance; `level` is the instance's hysteresis state
+    const Mesh& Pick(const LodModel& model, int& level, Vector3 center, float scale);
+};
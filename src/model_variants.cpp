@@ -0,0 +1,23 @@
+// model_variants.cpp - One model drawn with any of several materials chosen at draw time
+
+#include "model_variants.h"
+
+void ModelVariants::Load(Model base) {
+    Unload();
+    model = base;
+    materials.assign(1, model.materials[0]);
+}
+
+void ModelVariants::Unload() {
+    // Variant 0 is freed with the model
+    for (size_t i = 1; i < materials.size(); i++) MemFree(materials[i].maps);
+    if (model.meshCount > 0) UnloadModel(model);
+    materials.clear();
+    model = { 0 };
+}
+
+int ModelVariants::AddVariant(Material material) {
+    materials.push_back(material);
+    return (int)materials.size() - 1;
+}
+
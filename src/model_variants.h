@@ -0,0 +1,21 @@
+// model_variants.h - One model drawn with any of several materials chosen at draw time
+#pragma once
+
+#include "raylib.h"
+#include <vector>
+
+// A model plus alternative materials for it. Every variant draws the same meshes, so a
+// shader or colour toggle costs one Material instead of a second copy of the geometry.
+// A variant's material replaces the material of every mesh in the model.
+struct ModelVariants {
+    Model model = { 0 };
+    std::vector<Material> materials;    // Index = variant; 0 is the model's own material
+    
+    // Take ownership of the model
+    void Load(Model base);
+    void Unload();
+    
+    // Add a material and return its variant index. The variant owns the material's map
+    // array but, like raylib models, not its shader or textures.
+    int AddVariant(Material material);
+};
@@ -0,0 +1,151 @@
+// moebius_post.cpp - Moebius post-process (posterize + ink outlines) with a luminance prepass
+
+#include "moebius_post.h"
+#include "gpu_timer.h"
+#include "rlgl.h"
+
+static const char* MOEBIUS_VS = "resources/shaders/moebius.vs";
+
+// Render texture with a single R8 colour attachment (sampled as grey) and no depth
+static RenderTexture2D LoadLumaTarget(int width, int height) {
+    RenderTexture2D target = { 0 };
+    target.id = rlLoadFramebuffer();
+    target.texture.id = rlLoadTexture(nullptr, width, height, RL_PIXELFORMAT_UNCOMPRESSED_GRAYSCALE, 1);
+    target.texture.width = width;
+    target.texture.height = height;
+    target.texture.mipmaps = 1;
+    target.texture.format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE;
+    rlFramebufferAttach(target.id, target.texture.id, RL_ATTACHMENT_COLOR_CHANNEL0, RL_ATTACHMENT_TEXTURE2D, 0);
+    if (!rlFramebufferComplete(target.id)) {
+        TraceLog(LOG_WARNING, "MoebiusPost: luminance target %dx%d incomplete", width, height);
+    }
+    SetTextureFilter(target.texture, TEXTURE_FILTER_BILINEAR);
+    return target;
+}
+
+// Draw the same UV region of src (from the origin, region.x by region.y of its size) into
+// dst. Render textures are stored bottom-up, so the region sits at the bottom of dst in
+// raylib's top-down coordinates.
+static void DrawRegion(Texture2D src, Vector2 region, RenderTexture2D dst) {
+    float dw = region.x * dst.texture.width, dh = region.y * dst.texture.height;
+    DrawTexturePro(src,
+        (Rectangle){ 0, 0, region.x * src.width, -region.y * src.height },
+        (Rectangle){ 0, dst.texture.height - dh, dw, dh }, (Vector2){ 0, 0 }, 0.0f, WHITE);
+}
+
+void MoebiusPost::Load() {
+    Unload();
+    Reload();
+}
+
+void MoebiusPost::Unload() {
+    if (reference.id != 0) {
+        UnloadShader(reference); UnloadShader(luma); UnloadShader(edge);
+        UnloadShader(combine); UnloadShader(upsample);
+    }
+    reference = luma = edge = combine = upsample = { 0 };
+    if (lumaTarget.id != 0) UnloadRenderTexture(lumaTarget);
+    if (edgeTarget.id != 0) UnloadRenderTexture(edgeTarget);
+    lumaTarget = edgeTarget = { 0 };
+}
+
+void MoebiusPost::Reload() {
+    if (reference.id != 0) {
+        UnloadShader(reference); UnloadShader(luma); UnloadShader(edge);
+        UnloadShader(combine); UnloadShader(upsample);
+    }
+    reference = LoadShader(MOEBIUS_VS, "resources/shaders/moebius.fs");
+    luma = LoadShader(MOEBIUS_VS, "resources/shaders/moebius_luma.fs");
+    edge = LoadShader(MOEBIUS_VS, "resources/shaders/moebius_edge.fs");
+    combine = LoadShader(MOEBIUS_VS, "resources/shaders/moebius_combine.fs");
+    upsample = LoadShader(MOEBIUS_VS, "resources/shaders/moebius_upsample.fs");
+    
+    referenceResLoc = GetShaderLocation(reference, "resolution");
+    referenceRegionLoc = GetShaderLocation(reference, "region");
+    edgeResLoc = GetShaderLocation(edge, "resolution");
+    edgeRegionLoc = GetShaderLocation(edge, "region");
+    combineLumaLoc = GetShaderLocation(combine, "lumaTexture");
+    combineResLoc = GetShaderLocation(combine, "lumaResolution");
+    combineRegionLoc = GetShaderLocation(combine, "region");
+    upsampleEdgeLoc = GetShaderLocation(upsample, "edgeTexture");
+    upsampleResLoc = GetShaderLocation(upsample, "edgeResolution");
+    upsampleRegionLoc = GetShaderLocation(upsample, "region");
+}
+
+void MoebiusPost::CycleMode() {
+    mode = (mode + 1) % MOEBIUS_MODES;
+    framesInMode = 0;
+}
+
+void MoebiusPost::Prepare(Texture2D scene, int width, int height) {
+    if (mode == MOEBIUS_REFERENCE) return;
+    
+    // Intermediate targets follow the scene texture, halved in MOEBIUS_HALF
+    int lw = scene.width, lh = scene.height;
+    if (mode == MOEBIUS_HALF) {
+        lw = lw / 2 > 0 ? lw / 2 : 1;
+        lh = lh / 2 > 0 ? lh / 2 : 1;
+    }
+    if (lumaTarget.texture.width != lw || lumaTarget.texture.height != lh) {
+        if (lumaTarget.id != 0) UnloadRenderTexture(lumaTarget);
+        lumaTarget = LoadLumaTarget(lw, lh);
+    }
+    Vector2 region = { (float)width / scene.width, (float)height / scene.height };
+    
+    BeginTextureMode(lumaTarget);
+        ClearBackground(BLACK);
+        BeginShaderMode(luma);
+        DrawRegion(scene, region, lumaTarget);
+        EndShaderMode();
+    EndTextureMode();
+    
+    if (mode != MOEBIUS_HALF) return;
+    
+    // Edges are texelFetched by the upsample, so the target is never filtered
+    if (edgeTarget.texture.width != lw || edgeTarget.texture.height != lh) {
+        if (edgeTarget.id != 0) UnloadRenderTexture(edgeTarget);
+        edgeTarget = LoadRenderTexture(lw, lh);
+    }
+    float res[2] = { (float)lw, (float)lh };
+    SetShaderValue(edge, edgeResLoc, res, SHADER_UNIFORM_VEC2);
+    SetShaderValue(edge, edgeRegionLoc, &region, SHADER_UNIFORM_VEC2);
+    
+    BeginTextureMode(edgeTarget);
+        ClearBackground(BLACK);
+        BeginShaderMode(edge);
+        DrawRegion(lumaTarget.texture, region, edgeTarget);
+        EndShaderMode();
+    EndTextureMode();
+}
+
+void MoebiusPost::Draw(Texture2D scene, int width, int height, Rectangle dest) {
+    Rectangle source = { 0, 0, (float)width, -(float)height };
+    Vector2 region = { (float)width / scene.width, (float)height / scene.height };
+    
+    if (mode == MOEBIUS_REFERENCE) {
+        float res[2] = { (float)scene.width, (float)scene.height };
+        SetShaderValue(reference, referenceResLoc, res, SHADER_UNIFORM_VEC2);
+        SetShaderValue(reference, referenceRegionLoc, &region, SHADER_UNIFORM_VEC2);
+        BeginShaderMode(reference);
+    } else if (mode == MOEBIUS_PREPASS) {
+        float res[2] = { (float)lumaTarget.texture.width, (float)lumaTarget.texture.height };
+        SetShaderValue(combine, combineResLoc, res, SHADER_UNIFORM_VEC2);
+        SetShaderValue(combine, combineRegionLoc, &region, SHADER_UNIFORM_VEC2);
+        BeginShaderMode(combine);
+        SetShaderValueTexture(combine, combineLumaLoc, lumaTarget.texture);
+    } else {
+        float res[2] = { (float)edgeTarget.texture.width, (float)edgeTarget.texture.height };
+        SetShaderValue(upsample, upsampleResLoc, res, SHADER_UNIFORM_VEC2);
+        SetShaderValue(upsample, upsampleRegionLoc, &region, SHADER_UNIFORM_VEC2);
+        BeginShaderMode(upsample);
+        SetShaderValueTexture(upsample, upsampleEdgeLoc, edgeTarget.texture);
+    }
+    DrawTexturePro(scene, source, dest, (Vector2){ 0, 0 }, 0.0f, WHITE);
+    EndShaderMode();
+}
+
+void MoebiusPost::RecordTime(float ms) {
+    // Timer results lag by up to GPU_TIMER_FRAMES frames; older ones belong to the last mode.
+    // 0 is a pass time not measured yet.
+    if (++framesInMode > GPU_TIMER_FRAMES && ms > 0.0f) modeMs[mode] = ms;
+}
@@ -0,0 +1,47 @@
+// moebius_post.h - Moebius post-process (posterize + ink outlines) with a luminance prepass
+#pragma once
+
+#include "raylib.h"
+
+// Ways of running the effect, cycled for A/B timing
+const int MOEBIUS_REFERENCE = 0;    // Single pass: 9 colour fetches and luminance dots per pixel
+const int MOEBIUS_PREPASS = 1;      // Luminance prepass to R8, edges from 8 single-channel fetches
+const int MOEBIUS_HALF = 2;         // Prepass and edges at half resolution, edge-aware upsample
+const int MOEBIUS_MODES = 3;
+
+// The scene is a region at the top-left of a render texture (see DynamicResolution);
+// intermediate targets cover the same UV region so every pass samples with the scene's UVs,
+// and the shaders keep neighbour fetches inside it (a `region` uniform, as in PostChain).
+struct MoebiusPost {
+    Shader reference = { 0 };       // moebius.fs
+    Shader luma = { 0 };
+    Shader edge = { 0 };
+    Shader combine = { 0 };
+    Shader upsample = { 0 };
+    int referenceResLoc = -1, referenceRegionLoc = -1;
+    int edgeResLoc = -1, edgeRegionLoc = -1;
+    int combineLumaLoc = -1, combineResLoc = -1, combineRegionLoc = -1;
+    int upsampleEdgeLoc = -1, upsampleResLoc = -1, upsampleRegionLoc = -1;
+    
+    RenderTexture2D lumaTarget = { 0 };     // Single channel, full or half resolution
+    RenderTexture2D edgeTarget = { 0 };     // Half resolution: luminance, ink coverage
+    
+    int mode = MOEBIUS_PREPASS;
+    float modeMs[MOEBIUS_MODES] = {};       // Last GPU time measured in each mode
+    int framesInMode = 0;
+    
+    void Load();
+    void Unload();
+    void Reload();                  // Shaders only, for hot reload
+    void CycleMode();
+    
+    // Before BeginDrawing: the passes that write intermediate targets for the
+    // width x height scene region
+    void Prepare(Texture2D scene, int width, int height);
+    
+    // Draw the scene region stretched over dest with the effect
+    void Draw(Texture2D scene, int width, int height, Rectangle dest);
+    
+    // GPU time of Prepare + Draw; ignored until results from the current mode arrive
+    void RecordTime(float ms);
+};
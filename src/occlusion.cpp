@@ -0,0 +1,147 @@
+// occlusion.cpp - Software occlusion culling against a low-resolution depth pyramid
+
+#include "occlusion.h"
+#include "rlgl.h"
+#include <algorithm>
+#include <cmath>
+
+static Vector4 TransformPoint(const Matrix& m, Vector3 p) {
+    return {
+        m.m0 * p.x + m.m4 * p.y + m.m8 * p.z + m.m12,
+        m.m1 * p.x + m.m5 * p.y + m.m9 * p.z + m.m13,
+        m.m2 * p.x + m.m6 * p.y + m.m10 * p.z + m.m14,
+        m.m3 * p.x + m.m7 * p.y + m.m11 * p.z + m.m15
+    };
+}
+
+static Vector4 Lerp4(Vector4 a, Vector4 b, float t) {
+    return { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t };
+}
+
+// Clip coordinates to buffer pixels, with 1/w in z
+static Vector3 ToScreen(Vector4 clip) {
+    float invW = 1.0f / clip.w;
+    return {
+        (clip.x * invW * 0.5f + 0.5f) * OCCLUSION_WIDTH,
+        (0.5f - clip.y * invW * 0.5f) * OCCLUSION_HEIGHT,
+        invW
+    };
+}
+
+// Keep the nearest depth per covered pixel center; 1/w interpolates linearly in screen space
+static void RasterizeTriangle(std::vector<float>& depth, Vector3 a, Vector3 b, Vector3 c) {
+    float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    if (fabsf(area) < 1e-6f) return;
+    float sign = area > 0.0f ? 1.0f : -1.0f;
+    float invArea = 1.0f / fabsf(area);
+    
+    int x0 = std::max(0, (int)floorf(std::min({ a.x, b.x, c.x })));
+    int x1 = std::min(OCCLUSION_WIDTH - 1, (int)ceilf(std::max({ a.x, b.x, c.x })));
+    int y0 = std::max(0, (int)floorf(std::min({ a.y, b.y, c.y })));
+    int y1 = std::min(OCCLUSION_HEIGHT - 1, (int)ceilf(std::max({ a.y, b.y, c.y })));
+    
+    for (int y = y0; y <= y1; y++) {
+        float py = (float)y + 0.5f;
+        for (int x = x0; x <= x1; x++) {
+            float px = (float)x + 0.5f;
+            float wa = sign * ((c.x - b.x) * (py - b.y) - (c.y - b.y) * (px - b.x));
+            float wb = sign * ((a.x - c.x) * (py - c.y) - (a.y - c.y) * (px - c.x));
+            float wc = sign * ((b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x));
+            if (wa < 0.0f || wb < 0.0f || wc < 0.0f) continue;
+            
+            float z = (wa * a.z + wb * b.z + wc * c.z) * invArea;
+            float& texel = depth[y * OCCLUSION_WIDTH + x];
+            if (z > texel) texel = z;
+        }
+    }
+}
+
+void OcclusionBuffer::Begin(Matrix viewProj) {
+    viewProjection = viewProj;
+    occluderTriangles = 0;
+    for (int level = 0; level < OCCLUSION_LEVELS; level++) {
+        levels[level].assign((size_t)(OCCLUSION_WIDTH >> level) * (OCCLUSION_HEIGHT >> level), 0.0f);
+    }
+}
+
+void OcclusionBuffer::AddBox(BoundingBox box) {
+    Vector4 corners[8];
+    for (int i = 0; i < 8; i++) {
+        Vector3 p = { (i & 1) ? box.max.x : box.min.x, (i & 2) ? box.max.y : box.min.y, (i & 4) ? box.max.z : box.min.z };
+        corners[i] = TransformPoint(viewProjection, p);
+    }
+    
+    // Faces as corner quads (-x, +x, -y, +y, -z, +z)
+    static const int faces[6][4] = {
+        { 0, 4, 6, 2 }, { 1, 3, 7, 5 }, { 0, 1, 5, 4 }, { 2, 6, 7, 3 }, { 0, 2, 3, 1 }, { 4, 5, 7, 6 }
+    };
+    for (const int* face : faces) {
+        // Clip the quad against the near plane (w >= near) so boxes around the camera still occlude
+        Vector4 polygon[8];
+        int count = 0;
+        for (int i = 0; i < 4; i++) {
+            Vector4 p = corners[face[i]], q = corners[face[(i + 1) % 4]];
+            float dp = p.w - RL_CULL_DISTANCE_NEAR, dq = q.w - RL_CULL_DISTANCE_NEAR;
+            if (dp >= 0.0f) polygon[count++] = p;
+            if ((dp >= 0.0f) != (dq >= 0.0f)) polygon[count++] = Lerp4(p, q, dp / (dp - dq));
+        }
+        if (count < 3) continue;
+        
+        Vector3 screen[8];
+        for (int i = 0; i < count; i++) screen[i] = ToScreen(polygon[i]);
+        for (int i = 1; i + 1 < count; i++) {
+            RasterizeTriangle(levels[0], screen[0], screen[i], screen[i + 1]);
+            occluderTriangles++;
+        }
+    }
+}
+
+void OcclusionBuffer::Finish() {
+    for (int level = 1; level < OCCLUSION_LEVELS; level++) {
+        const std::vector<float>& fine = levels[level - 1];
+        std::vector<float>& coarse = levels[level];
+        int fineWidth = OCCLUSION_WIDTH >> (level - 1);
+        int width = OCCLUSION_WIDTH >> level, height = OCCLUSION_HEIGHT >> level;
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                const float* row0 = &fine[(2 * y) * fineWidth + 2 * x];
+                const float* row1 = row0 + fineWidth;
+                coarse[y * width + x] = std::min(std::min(row0[0], row0[1]), std::min(row1[0], row1[1]));
+            }
+        }
+    }
+}
+
+bool OcclusionBuffer::BoxVisible(BoundingBox box) const {
+    if (levels[0].empty()) return true;
+    
+    float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f, nearest = 0.0f;
+    for (int i = 0; i < 8; i++) {
+        Vector3 p = { (i & 1) ? box.max.x : box.min.x, (i & 2) ? box.max.y : box.min.y, (i & 4) ? box.max.z : box.min.z };
+        Vector4 clip = TransformPoint(viewProjection, p);
+        if (clip.w <= RL_CULL_DISTANCE_NEAR) return true;   // Reaches the camera plane
+        Vector3 s = ToScreen(clip);
+        minX = std::min(minX, s.x); maxX = std::max(maxX, s.x);
+        minY = std::min(minY, s.y); maxY = std::max(maxY, s.y);
+        nearest = std::max(nearest, s.z);
+    }
+    
+    // Grow the rectangle by a pixel: occluder edges mark pixels they only partly cover,
+    // and the uncovered neighbour across the edge keeps such boxes visible
+    if (maxX < 0.0f || maxY < 0.0f || minX >= OCCLUSION_WIDTH || minY >= OCCLUSION_HEIGHT) return true;
+    int x0 = std::max(0, (int)floorf(minX) - 1), x1 = std::min(OCCLUSION_WIDTH - 1, (int)floorf(maxX) + 1);
+    int y0 = std::max(0, (int)floorf(minY) - 1), y1 = std::min(OCCLUSION_HEIGHT - 1, (int)floorf(maxY) + 1);
+    
+    // Coarsest detail where the rectangle spans at most 2x2 texels
+    int level = 0;
+    while (level < OCCLUSION_LEVELS - 1 && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1)) level++;
+    
+    const std::vector<float>& depth = levels[level];
+    int width = OCCLUSION_WIDTH >> level;
+    for (int y = y0 >> level; y <= y1 >> level; y++) {
+        for (int x = x0 >> level; x <= x1 >> level; x++) {
+            if (depth[y * width + x] <= nearest) return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,34 @@
+// occlusion.h - Software occlusion culling against a low-resolution depth pyramid
+#pragma once
+
+#include "raylib.h"
+#include <vector>
+
+const int OCCLUSION_WIDTH = 256;
+const int OCCLUSION_HEIGHT = 128;
+const int OCCLUSION_LEVELS = 8;     // 256x128 down to 2x1
+
+// Large occluders are rasterized on the CPU into a small depth buffer each frame, which is
+// then reduced into a hierarchical-Z pyramid where each texel keeps the farthest depth below
+// it. A bounding box is hidden when its nearest point lies behind every texel of the level
+// that covers its screen rectangle with at most 2x2 texels, so each test is a handful of reads.
+// Depth is stored as 1/w (0 = no occluder), so nearer is larger. Perspective cameras only:
+// with an orthographic projection w is constant and nothing is ever reported hidden.
+struct OcclusionBuffer {
+    Matrix viewProjection = { 0 };
+    std::vector<float> levels[OCCLUSION_LEVELS];
+    int occluderTriangles = 0;      // Triangles rasterized since Begin
+    
+    // Clear for a new view (raylib order: MatrixMultiply(view, projection))
+    void Begin(Matrix viewProjection);
+    
+    // Rasterize a solid box. It must lie inside the real geometry: a pixel is marked as
+    // soon as its center is covered, so an occluder larger than the mesh hides too much.
+    void AddBox(BoundingBox box);
+    
+    // Build the pyramid once all occluders are in
+    void Finish();
+    
+    // False only if the box is certainly behind the occluders
+    bool BoxVisible(BoundingBox box) const;
+};
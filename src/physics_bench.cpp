@@ -0,0 +1,293 @@
+// physics_bench.cpp - Headless walking-mode benchmark
+//
+// Runs UpdateWalkingMode from a recorded or generated input script without opening
+// a window, and reports throughput and per-step latency. With --agents, a
+// CharacterBatch of that many agents replays the script instead, and with --rays it
+// times crosshair picks (PickFromView) instead. Usage:
+//   PhysicsBench [--steps N] [--rate HZ] [--boxes N] [--seed S]
+//                [--script FILE] [--broadphase bvh|grid|none]
+//                [--agents N] [--threads N] [--rays N]
+
+#include "raylib.h"
+#include "player.h"
+#include "level.h"
+#include "input_script.h"
+#include "character_batch.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+struct BenchOptions {
+    int steps = 100000;
+    int physicsRate = 60;
+    int boxCount = 0;               // Extra random boxes on top of the demo level
+    unsigned int seed = 1;
+    const char* scriptFile = nullptr;
+    int broadphase = BROADPHASE_BVH;
+    int agentCount = 0;             // 0 = single player through UpdateWalkingMode
+    int threadCount = 0;            // Workers for the agent batch (0 = hardware threads)
+    int rayCount = 0;               // > 0 = time this many crosshair picks instead
+};
+
+static void PrintUsage() {
+    printf("Usage: PhysicsBench [--steps N] [--rate HZ] [--boxes N] [--seed S]\n"
+           "                    [--script FILE] [--broadphase bvh|grid|none]\n"
+           "                    [--agents N] [--threads N] [--rays N]\n");
+}
+
+static bool ParseOptions(int argc, char** argv, BenchOptions* options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) return false;
+        if (!value) {
+            fprintf(stderr, "Missing value for %s\n", arg);
+            return false;
+        }
+        
+        if (strcmp(arg, "--steps") == 0) options->steps = atoi(value);
+        else if (strcmp(arg, "--rate") == 0) options->physicsRate = atoi(value);
+        else if (strcmp(arg, "--boxes") == 0) options->boxCount = atoi(value);
+        else if (strcmp(arg, "--seed") == 0) options->seed = (unsigned int)strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--script") == 0) options->scriptFile = value;
+        else if (strcmp(arg, "--agents") == 0) options->agentCount = atoi(value);
+        else if (strcmp(arg, "--threads") == 0) options->threadCount = atoi(value);
+        else if (strcmp(arg, "--rays") == 0) options->rayCount = atoi(value);
+        else if (strcmp(arg, "--broadphase") == 0) {
+            if (strcmp(value, "bvh") == 0) options->broadphase = BROADPHASE_BVH;
+            else if (strcmp(value, "grid") == 0) options->broadphase = BROADPHASE_GRID;
+            else if (strcmp(value, "none") == 0) options->broadphase = BROADPHASE_NONE;
+            else {
+                fprintf(stderr, "Unknown broadphase %s\n", value);
+                return false;
+            }
+        } else {
+            fprintf(stderr, "Unknown option %s\n", arg);
+            return false;
+        }
+        i++;
+    }
+    
+    if (options->steps <= 0 || options->physicsRate <= 0 || options->boxCount < 0 ||
+        options->agentCount < 0 || options->threadCount < 0 || options->rayCount < 0) {
+        fprintf(stderr, "Steps and rate must be positive, other counts non-negative\n");
+        return false;
+    }
+    return true;
+}
+
+static double Percentile(const std::vector<double>& sorted, double fraction) {
+    size_t index = (size_t)(fraction * (double)(sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+// Time crosshair picks from random eye positions over the level, then check a
+// sample of them against a brute-force raycast over every box
+static void RunPickBench(const BenchOptions& options, const CollisionWorld& world) {
+    unsigned int state = options.seed;
+    
+    float extent = sqrtf((float)world.boxes.size()) * 2.0f;
+    std::vector<Player> views(options.rayCount);
+    for (Player& view : views) {
+        // One draw per statement: argument evaluation order would differ between compilers
+        float x = (NextRandom(&state) * 2.0f - 1.0f) * extent;
+        float z = (NextRandom(&state) * 2.0f - 1.0f) * extent;
+        float yaw = NextRandom(&state) * 360.0f;
+        view = CreatePlayer({ x, 1.8f, z }, yaw);
+        view.pitch = (NextRandom(&state) * 2.0f - 1.0f) * 30.0f;
+    }
+    
+    // Warm-up pass so the timed pass sees the same cache state as a per-frame pick
+    int hits = 0;
+    for (const Player& view : views) hits += PickFromView(&view, view.position, world).index >= 0 ? 1 : 0;
+    
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now();
+    float distanceSum = 0.0f;
+    for (const Player& view : views) distanceSum += PickFromView(&view, view.position, world).distance;
+    double totalSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    
+    int checked = std::min(options.rayCount, 1000);
+    int mismatches = 0;
+    for (int i = 0; i < checked; i++) {
+        BVHHit hit = PickFromView(&views[i], views[i].position, world);
+        Ray ray = { views[i].position, GetForwardDirection(&views[i]) };
+        int bestIndex = -1;
+        float bestDistance = PICK_MAX_DISTANCE;
+        for (int b = 0; b < (int)world.boxes.size(); b++) {
+            RayCollision collision = GetRayCollisionBox(ray, GetBoxBounds(world.boxes[b]));
+            if (collision.hit && collision.distance >= 0.0f && collision.distance < bestDistance) {
+                bestDistance = collision.distance;
+                bestIndex = b;
+            }
+        }
+        
+        // Both must agree on whether and how far; a different box only at the same distance (a tie)
+        bool hitMismatch = (bestIndex < 0) != (hit.index < 0);
+        bool distanceMismatch = bestIndex >= 0 && fabsf(bestDistance - hit.distance) > 1e-4f;
+        if (hitMismatch || distanceMismatch) mismatches++;
+    }
+    
+    printf("Picks:       %d rays, %d hits (mean distance %.1f)\n", options.rayCount, hits,
+           distanceSum / (float)options.rayCount);
+    printf("Pick time:   %.1f ns per ray (%.0f rays/s)\n", totalSeconds * 1e9 / options.rayCount,
+           (double)options.rayCount / totalSeconds);
+    printf("Brute force: %d/%d mismatches\n", mismatches, checked);
+}
+
+// Step a batch of agents, each replaying the script from its own offset
+static void RunAgentBench(const BenchOptions& options, const CollisionWorld& world, const InputScript& script) {
+    WorkerPool pool;
+    pool.Start(options.threadCount);
+    
+    // Spawn on a square lattice centred on the level
+    CharacterBatch batch;
+    int side = (int)ceilf(sqrtf((float)options.agentCount));
+    for (int i = 0; i < options.agentCount; i++) {
+        float x = ((float)(i % side) - side * 0.5f) * 3.0f + 1.5f;
+        float z = ((float)(i / side) - side * 0.5f) * 3.0f + 1.5f;
+        batch.Add({ x, 1.8f, z }, (float)((i * 37) % 360));
+    }
+    
+    const float moveSpeed = 7.0f;
+    const float step = 1.0f / (float)options.physicsRate;
+    const size_t tickCount = script.ticks.size();
+    
+    std::vector<double> stepTimes;
+    stepTimes.reserve(options.steps);
+    long long totalTested = 0;
+    long long sleepingSteps = 0;
+    
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point runStart = Clock::now();
+    
+    for (int s = 0; s < options.steps; s++) {
+        Clock::time_point stepStart = Clock::now();
+        for (int i = 0; i < batch.count; i++) {
+            batch.SetInput(i, script.ticks[((size_t)i * 7919 + s) % tickCount], moveSpeed);
+        }
+        totalTested += batch.Step(world, step, pool);
+        Clock::time_point stepEnd = Clock::now();
+        sleepingSteps += batch.SleepingCount();
+        
+        stepTimes.push_back(std::chrono::duration<double, std::micro>(stepEnd - stepStart).count());
+    }
+    
+    double totalSeconds = std::chrono::duration<double>(Clock::now() - runStart).count();
+    std::sort(stepTimes.begin(), stepTimes.end());
+    double agentSteps = (double)options.steps * (double)batch.count;
+    
+    // Order-independent checksum so runs with different thread counts can be compared
+    double checksum = 0.0;
+    int groundedCount = 0;
+    for (int i = 0; i < batch.count; i++) {
+        checksum += batch.posX[i] + batch.posY[i] * 3.0 + batch.posZ[i] * 7.0;
+        groundedCount += batch.grounded[i];
+    }
+    
+    printf("Agents:      %d on %d workers\n", batch.count, pool.WorkerCount());
+    printf("Ticks:       %d in %.3f s (%.0f agent-steps/s, %.1f ns per agent-step)\n", options.steps,
+           totalSeconds, agentSteps / totalSeconds, totalSeconds * 1e9 / agentSteps);
+    printf("Tick time:   p50 %.1f us, p90 %.1f us, p99 %.1f us, max %.1f us\n",
+           Percentile(stepTimes, 0.50), Percentile(stepTimes, 0.90),
+           Percentile(stepTimes, 0.99), stepTimes.back());
+    printf("Candidates:  %.2f boxes tested per agent-step, %.1f%% agent-steps asleep\n",
+           (double)totalTested / agentSteps, 100.0 * (double)sleepingSteps / agentSteps);
+    printf("Final state: checksum %.3f, %d grounded\n", checksum, groundedCount);
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, &options)) {
+        PrintUsage();
+        return 1;
+    }
+    
+    // Keep the broadphase build logs out of the report
+    SetTraceLogLevel(LOG_WARNING);
+    
+    // Same level as the game, optionally buried in a random box field for scale
+    CollisionWorld world;
+    BuildDemoLevel(world.boxes);
+    if (options.boxCount > 0) {
+        float extent = sqrtf((float)options.boxCount) * 2.0f;
+        AddBoxField(world.boxes, options.boxCount, extent, options.seed);
+    }
+    world.broadphase = options.broadphase;
+    world.Build();
+    
+    // Input: a recorded script loops until the step count is reached
+    InputScript script;
+    script.physicsRate = options.physicsRate;
+    if (options.scriptFile) {
+        if (!script.Load(options.scriptFile) || script.ticks.empty()) {
+            fprintf(stderr, "Could not load input script %s\n", options.scriptFile);
+            return 1;
+        }
+        options.physicsRate = script.physicsRate;
+    } else {
+        script.Generate(options.steps, options.seed);
+    }
+    
+    const char* broadphaseNames[] = { "grid", "bvh", "none" };
+    printf("Boxes:       %d (%s broadphase)\n", (int)world.boxes.size(), broadphaseNames[world.broadphase]);
+    printf("Input:       %s, %d ticks at %d Hz\n", options.scriptFile ? options.scriptFile : "generated",
+           (int)script.ticks.size(), options.physicsRate);
+    
+    if (options.rayCount > 0) {
+        RunPickBench(options, world);
+        return 0;
+    }
+    
+    if (options.agentCount > 0) {
+        RunAgentBench(options, world, script);
+        return 0;
+    }
+    
+    Player player = CreatePlayer({ 0.0f, 1.8f, 10.0f }, -90.0f);
+    const float moveSpeed = 7.0f;
+    const float step = 1.0f / (float)options.physicsRate;
+    
+    std::vector<double> stepTimes;
+    stepTimes.reserve(options.steps);
+    long long totalTested = 0;
+    int sleepingSteps = 0;
+    
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point runStart = Clock::now();
+    
+    for (int i = 0; i < options.steps; i++) {
+        const PlayerInput& input = script.ticks[i % script.ticks.size()];
+        
+        Clock::time_point stepStart = Clock::now();
+        UpdateCameraLook(&player, input.look, 1.0f);
+        player.previousPosition = player.position;
+        totalTested += UpdateWalkingMode(&player, input, moveSpeed, world, step);
+        Clock::time_point stepEnd = Clock::now();
+        sleepingSteps += player.contacts.sleeping ? 1 : 0;
+        
+        stepTimes.push_back(std::chrono::duration<double, std::micro>(stepEnd - stepStart).count());
+    }
+    
+    double totalSeconds = std::chrono::duration<double>(Clock::now() - runStart).count();
+    std::sort(stepTimes.begin(), stepTimes.end());
+    
+    printf("Steps:       %d in %.3f s (%.0f steps/s)\n", options.steps, totalSeconds,
+           (double)options.steps / totalSeconds);
+    printf("Step time:   p50 %.2f us, p90 %.2f us, p99 %.2f us, max %.2f us\n",
+           Percentile(stepTimes, 0.50), Percentile(stepTimes, 0.90),
+           Percentile(stepTimes, 0.99), stepTimes.back());
+    printf("Candidates:  %.2f boxes tested per step, %.1f%% of steps asleep\n",
+           (double)totalTested / (double)options.steps, 100.0 * sleepingSteps / options.steps);
+    printf("Final state: pos (%.4f, %.4f, %.4f), yaw %.2f, grounded %s\n",
+           player.position.x, player.position.y, player.position.z, player.yaw,
+           player.isGrounded ? "yes" : "no");
+    
+    return 0;
+}
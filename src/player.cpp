@@ -0,0 +1,255 @@
+// player.cpp - First-person player state and movement controllers
+
+#include "player.h"
+#include "raymath.h"
+#include <cmath>
+#include <vector>
+
+// Spawn state used by the game and the headless bench
+Player CreatePlayer(Vector3 position, float yaw) {
+    Player player;
+    player.position = position;
+    player.previousPosition = position;
+    player.velocity = { 0.0f, 0.0f, 0.0f };
+    player.yaw = yaw;
+    player.pitch = 0.0f;
+    player.height = 1.8f;
+    player.radius = 0.3f;
+    player.isGrounded = false;
+    player.noclipMode = false;
+    return player;
+}
+
+// Update camera look direction from a mouse delta (shared between modes)
+void UpdateCameraLook(Player* player, Vector2 lookDelta, float mouseSensitivity) {
+    player->yaw += lookDelta.x * mouseSensitivity;
+    player->pitch -= lookDelta.y * mouseSensitivity;
+    
+    // Clamp pitch to prevent camera flip
+    if (player->pitch > 89.0f) player->pitch = 89.0f;
+    if (player->pitch < -89.0f) player->pitch = -89.0f;
+}
+
+// Get forward direction from player angles
+Vector3 GetForwardDirection(const Player* player) {
+    Vector3 forward;
+    forward.x = cosf(DEG2RAD * player->yaw) * cosf(DEG2RAD * player->pitch);
+    forward.y = sinf(DEG2RAD * player->pitch);
+    forward.z = sinf(DEG2RAD * player->yaw) * cosf(DEG2RAD * player->pitch);
+    return Vector3Normalize(forward);
+}
+
+// Get flat forward direction (for walking - ignores pitch)
+Vector3 GetFlatForwardDirection(const Player* player) {
+    Vector3 forward;
+    forward.x = cosf(DEG2RAD * player->yaw);
+    forward.y = 0.0f;
+    forward.z = sinf(DEG2RAD * player->yaw);
+    return Vector3Normalize(forward);
+}
+
+// Box under the crosshair: BVH raycast from eye along the view direction
+BVHHit PickFromView(const Player* player, Vector3 eye, const CollisionWorld& world, float maxDistance) {
+    Ray ray = { eye, GetForwardDirection(player) };
+    return world.Raycast(ray, maxDistance);
+}
+
+// Noclip camera controller (flying mode), advanced by one physics tick
+void UpdateNoclipMode(Player* player, const PlayerInput& input, float moveSpeed, float deltaTime) {
+    Vector3 forward = GetForwardDirection(player);
+    Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, {0, 1, 0}));
+    Vector3 up = { 0.0f, 1.0f, 0.0f };
+    
+    Vector3 moveDir = { 0.0f, 0.0f, 0.0f };
+    
+    if (input.forward) moveDir = Vector3Add(moveDir, forward);
+    if (input.back) moveDir = Vector3Subtract(moveDir, forward);
+    if (input.left) moveDir = Vector3Subtract(moveDir, right);
+    if (input.right) moveDir = Vector3Add(moveDir, right);
+    if (input.up) moveDir = Vector3Add(moveDir, up);
+    if (input.down) moveDir = Vector3Subtract(moveDir, up);
+    
+    float currentSpeed = moveSpeed;
+    if (input.sprint) currentSpeed *= 2.5f;
+    
+    if (Vector3Length(moveDir) > 0.0f) {
+        moveDir = Vector3Normalize(moveDir);
+        moveDir = Vector3Scale(moveDir, currentSpeed * deltaTime);
+    }
+    
+    player->position = Vector3Add(player->position, moveDir);
+    player->velocity = { 0, 0, 0 };
+    player->isGrounded = false;
+}
+
+// Horizontal walking velocity for the held movement keys at the given yaw
+Vector3 GetWalkVelocity(float yaw, const PlayerInput& input, float moveSpeed) {
+    Vector3 forward = { cosf(DEG2RAD * yaw), 0.0f, sinf(DEG2RAD * yaw) };
+    Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, {0, 1, 0}));
+    
+    // Horizontal movement input
+    Vector3 moveDir = { 0.0f, 0.0f, 0.0f };
+    
+    if (input.forward) moveDir = Vector3Add(moveDir, forward);
+    if (input.back) moveDir = Vector3Subtract(moveDir, forward);
+    if (input.left) moveDir = Vector3Subtract(moveDir, right);
+    if (input.right) moveDir = Vector3Add(moveDir, right);
+    
+    float currentSpeed = moveSpeed;
+    if (input.sprint) currentSpeed *= 2.0f;
+    
+    if (Vector3Length(moveDir) > 0.0f) {
+        moveDir = Vector3Normalize(moveDir);
+    }
+    
+    return Vector3Scale(moveDir, currentSpeed);
+}
+
+// Walking mode with gravity and collision, advanced by one physics tick
+// Only boxes returned by the world's broadphase are tested; returns how many were tested
+int UpdateWalkingMode(Player* player, const PlayerInput& input, float moveSpeed, const CollisionWorld& world,
+                      float deltaTime) {
+    // Apply horizontal velocity
+    Vector3 walkVelocity = GetWalkVelocity(player->yaw, input, moveSpeed);
+    player->velocity.x = walkVelocity.x;
+    player->velocity.z = walkVelocity.z;
+    
+    return StepWalkingBody(&player->position, &player->velocity, &player->isGrounded,
+                           player->radius, player->height, input.jump, world, deltaTime, &player->contacts);
+}
+
+// Exact comparison: a sleeping body must be bit-for-bit where it went to sleep
+static bool SamePosition(Vector3 a, Vector3 b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+static bool ContainsBox(const BoundingBox& outer, const BoundingBox& inner) {
+    return inner.min.x >= outer.min.x && inner.max.x <= outer.max.x &&
+           inner.min.y >= outer.min.y && inner.max.y <= outer.max.y &&
+           inner.min.z >= outer.min.z && inner.max.z <= outer.max.z;
+}
+
+// Make sure the cached candidates cover area, re-querying the broadphase with a
+// margin only when they don't. The narrow phase tolerates the extra boxes.
+static void RefreshContacts(ContactCache* cache, const CollisionWorld& world, BoundingBox area) {
+    if (cache->worldVersion == world.version && ContainsBox(cache->area, area)) return;
+    
+    Vector3 margin = { CONTACT_CACHE_MARGIN, CONTACT_CACHE_MARGIN, CONTACT_CACHE_MARGIN };
+    cache->area = { Vector3Subtract(area.min, margin), Vector3Add(area.max, margin) };
+    cache->worldVersion = world.version;
+    cache->candidates.clear();
+    world.QueryBox(cache->area, cache->candidates);
+    cache->nearby.Gather(world.soa, cache->candidates);
+}
+
+// Gravity, jump, collision and ground snapping for one walking body
+int StepWalkingBody(Vector3* position, Vector3* velocity, bool* isGrounded, float radius, float height,
+                    bool jump, const CollisionWorld& world, float deltaTime, ContactCache* cache) {
+    // Resting with no input: nothing below can change, so skip the tick
+    bool idle = *isGrounded && velocity->x == 0.0f && velocity->z == 0.0f && !jump;
+    if (idle && cache->sleeping && cache->worldVersion == world.version &&
+        SamePosition(*position, cache->restPosition)) {
+        velocity->y = 0.0f;
+        return 0;
+    }
+    
+    // Apply gravity
+    if (!*isGrounded) {
+        velocity->y -= GRAVITY * deltaTime;
+    }
+    
+    // Jump
+    if (jump && *isGrounded) {
+        velocity->y = JUMP_FORCE;
+        *isGrounded = false;
+    }
+    
+    // Horizontal displacement for this tick
+    Vector3 newPos = *position;
+    Vector3 move = { velocity->x * deltaTime, 0.0f, velocity->z * deltaTime };
+    
+    // Broadphase: boxes the footprint can touch anywhere along the move (padded by radius
+    // to cover push-out), served from the contact cache while it still covers the area
+    const ColliderSoA& nearby = cache->nearby;
+    float reach = radius * 2.0f;
+    RefreshContacts(cache, world, {
+        { fminf(newPos.x, newPos.x + move.x) - reach, newPos.y - height, fminf(newPos.z, newPos.z + move.z) - reach },
+        { fmaxf(newPos.x, newPos.x + move.x) + reach, newPos.y, fmaxf(newPos.z, newPos.z + move.z) + reach }
+    });
+    int tested = nearby.count;
+    
+    // Push out of boxes we already overlap (spawn, leaving noclip, landing on an edge).
+    // Kernel hits are re-checked after earlier push-outs; a second pass catches boxes
+    // that only became overlapping because of a push.
+    for (int pass = 0; pass < 2; pass++) {
+        bool pushed = false;
+        for (int first = 0; first < nearby.PaddedCount(); first += COLLIDER_SIMD_WIDTH) {
+            unsigned int mask = HorizontalContactMask(nearby, first, newPos, radius, height);
+            for (int lane = 0; mask != 0; lane++, mask >>= 1) {
+                if (!(mask & 1)) continue;
+                BoundingBox bounds = nearby.Bounds(first + lane);
+                if (ShouldApplyHorizontalCollision(newPos, radius, height, bounds)) {
+                    newPos = ResolveCollision(newPos, radius, height, bounds);
+                    pushed = true;
+                }
+            }
+        }
+        if (!pushed) break;
+    }
+    
+    // Sweep the move against the blocking boxes and slide along what we hit,
+    // so fast movement or long ticks can't tunnel through thin geometry
+    newPos = MoveAndSlide(newPos, move, radius, height, nearby);
+    
+    // Apply vertical movement; remember how far the feet dropped so tops crossed
+    // during this tick still count as ground
+    float fallDistance = fmaxf(-velocity->y * deltaTime, 0.0f);
+    newPos.y += velocity->y * deltaTime;
+    
+    // Reset grounded state - will be set true if we find ground below
+    bool foundGround = false;
+    float groundY = GROUND_LEVEL;
+    
+    // Check ground level first
+    if (newPos.y - height <= GROUND_LEVEL + GROUND_SNAP_ABOVE) {
+        foundGround = true;
+        groundY = GROUND_LEVEL;
+    }
+    
+    // Check if standing on any box near the resolved position
+    // (only counts as ground if we're falling or stationary vertically)
+    if (velocity->y <= 0.01f) {
+        RefreshContacts(cache, world, {
+            { newPos.x - radius, newPos.y - height - GROUND_SNAP_ABOVE, newPos.z - radius },
+            { newPos.x + radius, newPos.y + fallDistance, newPos.z + radius }
+        });
+        tested += nearby.count;
+        
+        for (int first = 0; first < nearby.PaddedCount(); first += COLLIDER_SIMD_WIDTH) {
+            unsigned int mask = GroundSupportMask(nearby, first, newPos, radius, height, fallDistance);
+            for (int lane = 0; mask != 0; lane++, mask >>= 1) {
+                if (!(mask & 1)) continue;
+                float top = nearby.maxY[first + lane];
+                if (top > groundY) groundY = top;
+                foundGround = true;
+            }
+        }
+    }
+    
+    // Apply ground detection
+    if (foundGround && velocity->y <= 0.01f) {
+        newPos.y = groundY + height;
+        velocity->y = 0;
+        *isGrounded = true;
+    } else {
+        *isGrounded = false;
+    }
+    
+    // A grounded tick that ended where it started will repeat exactly until input
+    // arrives, so the body can sleep from here on
+    cache->sleeping = idle && *isGrounded && SamePosition(newPos, *position);
+    cache->restPosition = newPos;
+    
+    *position = newPos;
+    return tested;
+}
@@ -0,0 +1,94 @@
+// player.h - First-person player state and movement controllers
+#pragma once
+
+#include "raylib.h"
+#include "collision.h"
+#include <vector>
+
+// Extra room around the broadphase query so small moves keep reusing the cached contacts
+const float CONTACT_CACHE_MARGIN = 0.5f;
+
+// Per-body contact cache. Holds the candidate boxes around the body, queried with a
+// margin; the broadphase only runs again once the body leaves the cached area or the
+// world is rebuilt. A grounded body that didn't move last tick and has no input sleeps:
+// its tick is skipped entirely until it gets input, is moved, or the world changes. The
+// rest position and world version stand in for tracking the box it stands on.
+struct ContactCache {
+    BoundingBox area = {};          // Region the cached candidates cover
+    std::vector<int> candidates;    // World box indices, same order as nearby
+    ColliderSoA nearby;
+    unsigned int worldVersion = 0;  // CollisionWorld::version of the candidates (0 = empty)
+    Vector3 restPosition = {};      // Position when the body went to sleep
+    bool sleeping = false;
+};
+
+// Player state structure
+struct Player {
+    Vector3 position;
+    Vector3 previousPosition;   // Position at the previous physics tick (for interpolation)
+    Vector3 velocity;
+    float yaw;
+    float pitch;
+    float height;           // Player eye height
+    float radius;           // Collision radius
+    bool isGrounded;
+    bool noclipMode;
+    ContactCache contacts;
+};
+
+// One tick worth of controller input, decoupled from the window/keyboard so the
+// same controllers can be driven by scripts (see input_script.h)
+struct PlayerInput {
+    Vector2 look;           // Yaw/pitch change in degrees, applied before this tick
+    bool forward;           // W
+    bool back;              // S
+    bool left;              // A
+    bool right;             // D
+    bool up;                // Space (noclip)
+    bool down;              // Shift (noclip)
+    bool sprint;            // Ctrl
+    bool jump;              // Space pressed since the last tick
+};
+
+// Physics constants
+const float GRAVITY = 20.0f;
+const float JUMP_FORCE = 8.0f;
+const float GROUND_LEVEL = 0.0f;
+
+// How far the crosshair pick reaches
+const float PICK_MAX_DISTANCE = 100.0f;
+
+// Spawn state used by the game and the headless bench
+Player CreatePlayer(Vector3 position, float yaw);
+
+// Update camera look direction from a mouse delta (shared between modes)
+// Pass a sensitivity of 1 to apply a PlayerInput::look that is already in degrees
+void UpdateCameraLook(Player* player, Vector2 lookDelta, float mouseSensitivity);
+
+// Get forward direction from player angles
+Vector3 GetForwardDirection(const Player* player);
+
+// Get flat forward direction (for walking - ignores pitch)
+Vector3 GetFlatForwardDirection(const Player* player);
+
+// Box under the crosshair: BVH raycast from eye along the view direction.
+// Returns index -1 when nothing is within maxDistance.
+BVHHit PickFromView(const Player* player, Vector3 eye, const CollisionWorld& world,
+                    float maxDistance = PICK_MAX_DISTANCE);
+
+// Noclip camera controller (flying mode), advanced by one physics tick
+void UpdateNoclipMode(Player* player, const PlayerInput& input, float moveSpeed, float deltaTime);
+
+// Horizontal walking velocity for the held movement keys at the given yaw
+Vector3 GetWalkVelocity(float yaw, const PlayerInput& input, float moveSpeed);
+
+// Walking mode with gravity and collision, advanced by one physics tick
+// Only boxes returned by the world's broadphase are tested; returns how many were tested
+int UpdateWalkingMode(Player* player, const PlayerInput& input, float moveSpeed, const CollisionWorld& world,
+                      float deltaTime);
+
+// Walking rules shared by the player and CharacterBatch: gravity, jump, depenetration,
+// swept slide and ground snapping. Horizontal velocity must already be set from input.
+// Returns how many boxes the narrow phase tested (0 while sleeping).
+int StepWalkingBody(Vector3* position, Vector3* velocity, bool* isGrounded, float radius, float height,
+                    bool jump, const CollisionWorld& world, float deltaTime, ContactCache* cache);
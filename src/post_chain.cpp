@@ -0,0 +1,269 @@
+// post_chain.cpp - Ordered post-processing passes over ping-pong render textures
+
+#include "post_chain.h"
+
+static const char* FUSED_HEADER =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec2 resolution;\n"
+    "uniform vec2 region;\n"
+    "uniform float time;\n"
+    "out vec4 finalColor;\n";
+
+static std::string ReadText(const std::string& path) {
+    char* text = LoadFileText(path.c_str());
+    if (!text) return "";
+    std::string result = text;
+    UnloadFileText(text);
+    return result;
+}
+
+// Shader kind: compile the fragment shader and look up the uniforms RunStep sets
+static void LoadPassShader(PostPass& pass) {
+    pass.shader = LoadShader(nullptr, pass.path.c_str());
+    pass.resolutionLoc = GetShaderLocation(pass.shader, "resolution");
+    pass.regionLoc = GetShaderLocation(pass.shader, "region");
+    pass.timeLoc = GetShaderLocation(pass.shader, "time");
+}
+
+int PostChain::AddPoint(const char* name, const char* function, const char* path) {
+    PostPass pass;
+    pass.name = name;
+    pass.kind = POST_PASS_POINT;
+    pass.path = path;
+    pass.function = function;
+    pass.code = ReadText(pass.path);
+    passes.push_back(pass);
+    passes.back().timer.Load();
+    return (int)passes.size() - 1;
+}
+
+int PostChain::AddShader(const char* name, const char* path) {
+    PostPass pass;
+    pass.name = name;
+    pass.kind = POST_PASS_SHADER;
+    pass.path = path;
+    LoadPassShader(pass);
+    passes.push_back(pass);
+    passes.back().timer.Load();
+    return (int)passes.size() - 1;
+}
+
+int PostChain::AddCustom(const char* name, const std::function<void(Texture2D, int, int)>& prepare,
+                         const std::function<void(Texture2D, int, int, Rectangle)>& draw) {
+    PostPass pass;
+    pass.name = name;
+    pass.kind = POST_PASS_CUSTOM;
+    pass.prepare = prepare;
+    pass.draw = draw;
+    passes.push_back(pass);
+    passes.back().timer.Load();
+    return (int)passes.size() - 1;
+}
+
+void PostChain::Load() {
+    Unload();
+    copyTimer.Load();
+}
+
+void PostChain::Unload() {
+    for (PostPass& pass : passes) {
+        if (pass.shader.id != 0) UnloadShader(pass.shader);
+        pass.timer.Unload();
+    }
+    passes.clear();
+    for (auto& entry : fused) UnloadShader(entry.second.shader);
+    fused.clear();
+    for (RenderTexture2D& target : targets) {
+        if (target.id != 0) UnloadRenderTexture(target);
+        target = { 0 };
+    }
+    copyTimer.Unload();
+}
+
+void PostChain::Reload() {
+    for (PostPass& pass : passes) {
+        if (pass.kind == POST_PASS_POINT) pass.code = ReadText(pass.path);
+        if (pass.kind == POST_PASS_SHADER) {
+            UnloadShader(pass.shader);
+            LoadPassShader(pass);
+        }
+    }
+    for (auto& entry : fused) UnloadShader(entry.second.shader);
+    fused.clear();
+}
+
+void PostChain::Plan() {
+    order.clear();
+    steps.clear();
+    for (int i = 0; i < (int)passes.size(); i++) {
+        PostPass& pass = passes[i];
+        pass.step = -1;
+        pass.fused = false;
+        if (!pass.enabled) continue;
+        
+        // Extend the previous step if both it and this pass are point passes
+        int n = (int)order.size();
+        order.push_back(i);
+        if (fusion && pass.kind == POST_PASS_POINT && !steps.empty() &&
+            passes[order[steps.back().first]].kind == POST_PASS_POINT) {
+            steps.back().count++;
+        } else {
+            steps.push_back({ n, 1 });
+        }
+        pass.step = (int)steps.size() - 1;
+    }
+    for (const PostStep& step : steps) {
+        if (step.count < 2) continue;
+        for (int k = 0; k < step.count; k++) passes[order[step.first + k]].fused = true;
+    }
+    
+    // A timer's results lag by up to GPU_TIMER_FRAMES frames, so after its pass starts
+    // leading, or its step gains or loses passes, older ones measured something else
+    for (int i = 0; i < (int)passes.size(); i++) {
+        PostPass& pass = passes[i];
+        int count = 0, last = -1;
+        if (pass.step >= 0 && order[steps[pass.step].first] == i) {
+            count = steps[pass.step].count;
+            last = order[steps[pass.step].first + count - 1];
+        }
+        bool same = count > 0 && count == pass.ledCount && last == pass.ledLast;
+        pass.framesLeading = same ? pass.framesLeading + 1 : (count > 0 ? 1 : 0);
+        pass.ledCount = count;
+        pass.ledLast = last;
+    }
+    framesCopying = steps.empty() ? framesCopying + 1 : 0;
+}
+
+const FusedShader& PostChain::Fused(const PostStep& step) {
+    std::string key;
+    for (int k = 0; k < step.count; k++) {
+        if (k > 0) key += "+";
+        key += passes[order[step.first + k]].function;
+    }
+    auto it = fused.find(key);
+    if (it != fused.end()) return it->second;
+    
+    // Snippets in order, then a main that threads the colour through each function
+    std::string code = FUSED_HEADER;
+    std::string body;
+    for (int k = 0; k < step.count; k++) {
+        const PostPass& pass = passes[order[step.first + k]];
+        code += pass.code + "\n";
+        body += "    color = " + pass.function + "(color, uv);\n";
+    }
+    code += "void main() {\n"
+            "    vec2 uv = fragTexCoord / region;\n"
+            "    vec3 color = texture(texture0, fragTexCoord).rgb;\n" + body +
+            "    finalColor = vec4(color, 1.0);\n"
+            "}\n";
+    
+    FusedShader shader;
+    shader.shader = LoadShaderFromMemory(nullptr, code.c_str());
+    shader.resolutionLoc = GetShaderLocation(shader.shader, "resolution");
+    shader.regionLoc = GetShaderLocation(shader.shader, "region");
+    shader.timeLoc = GetShaderLocation(shader.shader, "time");
+    TraceLog(LOG_INFO, "PostChain: compiled %s", key.c_str());
+    return fused[key] = shader;
+}
+
+void PostChain::RunStep(const PostStep& step, Texture2D src, Rectangle dest) {
+    PostPass& first = passes[order[step.first]];
+    if (first.kind == POST_PASS_CUSTOM) {
+        first.draw(src, width, height, dest);
+        return;
+    }
+    
+    Shader shader = first.shader;
+    int resolutionLoc = first.resolutionLoc, regionLoc = first.regionLoc, timeLoc = first.timeLoc;
+    if (first.kind == POST_PASS_POINT) {
+        const FusedShader& fusedShader = Fused(step);
+        shader = fusedShader.shader;
+        resolutionLoc = fusedShader.resolutionLoc;
+        regionLoc = fusedShader.regionLoc;
+        timeLoc = fusedShader.timeLoc;
+    }
+    float resolution[2] = { (float)width, (float)height };
+    float region[2] = { (float)width / src.width, (float)height / src.height };
+    SetShaderValue(shader, resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
+    SetShaderValue(shader, regionLoc, region, SHADER_UNIFORM_VEC2);
+    SetShaderValue(shader, timeLoc, &time, SHADER_UNIFORM_FLOAT);
+    
+    BeginShaderMode(shader);
+    DrawTexturePro(src, (Rectangle){ 0, 0, (float)width, -(float)height }, dest, (Vector2){ 0, 0 }, 0.0f, WHITE);
+    EndShaderMode();
+}
+
+void PostChain::Prepare(Texture2D scene, int regionWidth, int regionHeight, float seconds) {
+    width = regionWidth;
+    height = regionHeight;
+    time = seconds;
+    Plan();
+    
+    // Intermediate steps keep the scene's layout, so the targets match its texture
+    if (steps.size() > 1 && (targets[0].texture.width != scene.width || targets[0].texture.height != scene.height)) {
+        for (RenderTexture2D& target : targets) {
+            if (target.id != 0) UnloadRenderTexture(target);
+            target = LoadRenderTexture(scene.width, scene.height);
+            SetTextureFilter(target.texture, TEXTURE_FILTER_BILINEAR);
+        }
+    }
+    
+    // Render textures are stored bottom-up: the region sits at the bottom in raylib coordinates
+    Rectangle region = { 0, (float)(scene.height - height), (float)width, (float)height };
+    source = scene;
+    int write = 0;
+    for (size_t s = 0; s + 1 < steps.size(); s++) {
+        PostPass& first = passes[order[steps[s].first]];
+        first.timer.Begin();
+        if (first.kind == POST_PASS_CUSTOM) first.prepare(source, width, height);
+        BeginTextureMode(targets[write]);
+            RunStep(steps[s], source, region);
+        EndTextureMode();
+        first.timer.End();
+        
+        source = targets[write].texture;
+        write = 1 - write;
+    }
+    
+    // The last step's timer spans its preparation here and its draw in Draw
+    if (!steps.empty()) {
+        PostPass& last = passes[order[steps.back().first]];
+        last.timer.Begin();
+        if (last.kind == POST_PASS_CUSTOM) last.prepare(source, width, height);
+    }
+}
+
+void PostChain::Draw(Rectangle dest) {
+    if (steps.empty()) {
+        copyTimer.Begin();
+        DrawTexturePro(source, (Rectangle){ 0, 0, (float)width, -(float)height }, dest, (Vector2){ 0, 0 }, 0.0f, WHITE);
+        copyTimer.End();
+        return;
+    }
+    RunStep(steps.back(), source, dest);
+    passes[order[steps.back().first]].timer.End();
+    
+    for (PostPass& pass : passes) pass.ms = pass.step >= 0 ? StepMs(steps[pass.step]) : 0.0f;
+}
+
+float PostChain::StepMs(const PostStep& step) const {
+    const PostPass& first = passes[order[step.first]];
+    return first.framesLeading > GPU_TIMER_FRAMES ? first.timer.ms : 0.0f;
+}
+
+bool PostChain::Measured() const {
+    if (steps.empty()) return framesCopying > GPU_TIMER_FRAMES;
+    for (const PostStep& step : steps) {
+        if (passes[order[step.first]].framesLeading <= GPU_TIMER_FRAMES) return false;
+    }
+    return true;
+}
+
+float PostChain::TotalMs() const {
+    if (steps.empty()) return framesCopying > GPU_TIMER_FRAMES ? copyTimer.ms : 0.0f;
+    float total = 0.0f;
+    for (const PostStep& step : steps) total += StepMs(step);
+    return total;
+}
@@ -0,0 +1,104 @@
+// post_chain.h - Ordered post-processing passes over ping-pong render textures
+#pragma once
+
+#include "raylib.h"
+#include "gpu_timer.h"
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+// How a pass is drawn
+const int POST_PASS_POINT = 0;      // Per-pixel colour function from a GLSL snippet; adjacent ones fuse
+const int POST_PASS_SHADER = 1;     // Full fragment shader that may read neighbours; runs alone
+const int POST_PASS_CUSTOM = 2;     // Drawn by callbacks, which may run their own passes first
+
+// A point snippet defines `vec3 <function>(vec3 color, vec2 uv)`, where uv is 0-1 over the
+// screen, and may use the uniforms `resolution` (region size in pixels) and `time`.
+// Shader passes get texture0, `resolution`, `region` (UV extent of the region) and `time`.
+struct PostPass {
+    std::string name;
+    int kind = POST_PASS_POINT;
+    bool enabled = false;
+    std::string path;               // Snippet or fragment shader file
+    std::string function;           // Point: the snippet's function name
+    std::string code;               // Point: snippet text
+    Shader shader = { 0 };          // Shader kind
+    int resolutionLoc = -1, regionLoc = -1, timeLoc = -1;
+    
+    // Custom kind: prepare runs outside any texture mode before the pass draws; draw
+    // renders the width x height source region over dest with the current target bound
+    std::function<void(Texture2D, int, int)> prepare;
+    std::function<void(Texture2D, int, int, Rectangle)> draw;
+    
+    GpuTimer timer;                 // Times the step this pass starts
+    int step = -1;                  // Step it ran in last frame, -1 if disabled
+    bool fused = false;             // Ran in a step together with other passes
+    float ms = 0.0f;                // GPU time of its step, 0 until measured
+    
+    // Frames in a row this pass has started the same step (count passes up to last);
+    // its timer's results belong to that step once past GPU_TIMER_FRAMES
+    int framesLeading = 0;
+    int ledCount = 0, ledLast = -1;
+};
+
+// Consecutive enabled passes drawn as one full-screen draw
+struct PostStep {
+    int first, count;               // Range of PostChain::order
+};
+
+// A compiled group of point snippets
+struct FusedShader {
+    Shader shader;
+    int resolutionLoc, regionLoc, timeLoc;
+};
+
+// Runs the enabled passes in order, each reading the previous one's output, through two
+// render textures swapped between steps; the last step draws straight to the screen.
+// Disabled passes are left out of the plan entirely, and with fusion, runs of point passes
+// that end up adjacent compile into one shader, so they cost one draw and one fetch.
+//
+// The scene is a region at the top-left of its texture (see DynamicResolution); every
+// intermediate step keeps that region and resolution, and only the last one upsamples.
+struct PostChain {
+    std::vector<PostPass> passes;
+    std::vector<int> order;         // Enabled passes, this frame
+    std::vector<PostStep> steps;
+    std::map<std::string, FusedShader> fused;   // By joined function names, built on demand
+    RenderTexture2D targets[2] = {};
+    GpuTimer copyTimer;             // The plain blit when no pass is enabled
+    int framesCopying = 0;
+    bool fusion = true;
+    
+    // Current frame
+    Texture2D source = { 0 };       // Input of the last step
+    int width = 0, height = 0;
+    float time = 0.0f;
+    
+    // Passes are appended in drawing order and start disabled; returns the pass index
+    int AddPoint(const char* name, const char* function, const char* path);
+    int AddShader(const char* name, const char* path);
+    int AddCustom(const char* name, const std::function<void(Texture2D, int, int)>& prepare,
+                  const std::function<void(Texture2D, int, int, Rectangle)>& draw);
+    
+    void Load();                    // Before adding passes (needs a GL context)
+    void Unload();
+    void Reload();                  // Snippets and shaders, for hot reload
+    
+    // Before BeginDrawing: plan the steps and run all but the last into the ping-pong targets
+    void Prepare(Texture2D scene, int regionWidth, int regionHeight, float seconds);
+    
+    // Last step, stretched over dest
+    void Draw(Rectangle dest);
+    
+    // GPU time of last frame's steps, counting those not measured since the plan changed as 0
+    float TotalMs() const;
+    float StepMs(const PostStep& step) const;
+    
+    // Every step of the current plan has been measured, so TotalMs covers them all
+    bool Measured() const;
+    
+    void Plan();
+    const FusedShader& Fused(const PostStep& step);
+    void RunStep(const PostStep& step, Texture2D src, Rectangle dest);
+};
@@ -0,0 +1,147 @@
+// render_queue.cpp - Sorted mesh draw submission with state-change counting
+
+#include "render_queue.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include <algorithm>
+
+// Key layouts, most significant bits first:
+//   opaque:      pass 2 | shader 10 | material 12 | mesh 16 | depth 24
+//   transparent: pass 2 | inverted depth 24 | shader 10 | material 12 | mesh 16
+// Ids wider than their field wrap, which only costs sort quality, never correctness.
+static const uint64_t DEPTH_MAX = 0xFFFFFF;
+
+static int KeyPass(uint64_t key) {
+    return (int)(key >> 62);
+}
+
+static uint64_t MakeKey(int pass, unsigned int shader, int material, unsigned int mesh, float distance) {
+    uint64_t depth = (uint64_t)(Clamp(distance / RENDER_QUEUE_MAX_DEPTH, 0.0f, 1.0f) * (float)DEPTH_MAX);
+    uint64_t state = ((uint64_t)(shader & 0x3FF) << 28) | ((uint64_t)(material & 0xFFF) << 16) | (mesh & 0xFFFF);
+    if (pass == RENDER_PASS_TRANSPARENT) {
+        return ((uint64_t)pass << 62) | ((DEPTH_MAX - depth) << 38) | state;
+    }
+    return ((uint64_t)pass << 62) | (state << 24) | depth;
+}
+
+// Binds needed to go from previous to item; a new shader also needs the material re-sent
+static void CountChanges(RenderStateChanges& changes, const RenderItem* previous, const RenderItem& item) {
+    bool shader = !previous || previous->material.shader.id != item.material.shader.id;
+    if (shader) changes.shaders++;
+    if (shader || previous->material.maps != item.material.maps) changes.materials++;
+    if (!previous || previous->mesh->vaoId != item.mesh->vaoId) changes.meshes++;
+}
+
+void RenderQueue::Begin(Vector3 cameraPosition) {
+    items.clear();
+    eye = cameraPosition;
+    submitted = {};
+    executed = {};
+}
+
+void RenderQueue::Submit(int pass, const Mesh& mesh, const Material& material, Matrix transform) {
+    int id = materialIds.emplace(material.maps, (int)materialIds.size()).first->second;
+    float distance = Vector3Distance(eye, (Vector3){ transform.m12, transform.m13, transform.m14 });
+    RenderItem item = { MakeKey(pass, material.shader.id, id, mesh.vaoId, distance), &mesh, material, transform };
+    CountChanges(submitted, items.empty() ? nullptr : &items.back(), item);
+    items.push_back(item);
+}
+
+// Same model matrix DrawModel builds
+static Matrix ModelTransform(const Model& model, Vector3 position, float scale) {
+    Matrix matScale = MatrixScale(scale, scale, scale);
+    Matrix matTranslation = MatrixTranslate(position.x, position.y, position.z);
+    return MatrixMultiply(model.transform, MatrixMultiply(matScale, matTranslation));
+}
+
+void RenderQueue::SubmitModel(int pass, const Model& model, Vector3 position, float scale) {
+    Matrix transform = ModelTransform(model, position, scale);
+    for (int i = 0; i < model.meshCount; i++) {
+        Submit(pass, model.meshes[i], model.materials[model.meshMaterial[i]], transform);
+    }
+}
+
+void RenderQueue::SubmitModel(int pass, const Model& model, const Material& material, Vector3 position, float scale) {
+    Matrix transform = ModelTransform(model, position, scale);
+    for (int i = 0; i < model.meshCount; i++) Submit(pass, model.meshes[i], material, transform);
+}
+
+void RenderQueue::Sort() {
+    if (!sorting) return;
+    std::stable_sort(items.begin(), items.end(), [](const RenderItem& a, const RenderItem& b) { return a.key < b.key; });
+}
+
+// Per-material state DrawMesh sends. ShaderTest's materials only use the diffuse map.
+static void BindMaterial(const Material& material) {
+    const int* locs = material.shader.locs;
+    const MaterialMap& diffuse = material.maps[MATERIAL_MAP_DIFFUSE];
+    if (locs[SHADER_LOC_COLOR_DIFFUSE] != -1) {
+        float values[4] = { diffuse.color.r / 255.0f, diffuse.color.g / 255.0f, diffuse.color.b / 255.0f, diffuse.color.a / 255.0f };
+        rlSetUniform(locs[SHADER_LOC_COLOR_DIFFUSE], values, SHADER_UNIFORM_VEC4, 1);
+    }
+    if (diffuse.texture.id > 0) {
+        int slot = 0;
+        rlActiveTextureSlot(slot);
+        rlEnableTexture(diffuse.texture.id);
+        rlSetUniform(locs[SHADER_LOC_MAP_DIFFUSE], &slot, SHADER_UNIFORM_INT, 1);
+    }
+}
+
+int RenderQueue::Draw(int pass) {
+    Matrix view = rlGetMatrixModelview();
+    Matrix projection = rlGetMatrixProjection();
+    const RenderItem* bound = nullptr;  // Item whose state is currently bound
+    int drawCalls = 0;
+    
+    for (const RenderItem& item : items) {
+        if (KeyPass(item.key) != pass) continue;
+        
+        // No vertex array to keep bound: release ours and let raylib bind the buffers itself
+        if (item.mesh->vaoId == 0) {
+            if (bound) {
+                rlActiveTextureSlot(0);
+                rlDisableTexture();
+                rlDisableVertexArray();
+                rlDisableShader();
+            }
+            CountChanges(executed, nullptr, item);
+            DrawMesh(*item.mesh, item.material, item.transform);
+            bound = nullptr;
+            drawCalls++;
+            continue;
+        }
+        
+        const int* locs = item.material.shader.locs;
+        bool shaderChanged = !bound || bound->material.shader.id != item.material.shader.id;
+        CountChanges(executed, bound, item);
+        if (shaderChanged) {
+            rlEnableShader(item.material.shader.id);
+            if (locs[SHADER_LOC_MATRIX_VIEW] != -1) rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_VIEW], view);
+            if (locs[SHADER_LOC_MATRIX_PROJECTION] != -1) rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_PROJECTION], projection);
+        }
+        if (shaderChanged || bound->material.maps != item.material.maps) BindMaterial(item.material);
+        if (!bound || bound->mesh->vaoId != item.mesh->vaoId) rlEnableVertexArray(item.mesh->vaoId);
+        
+        // Per-item matrices, as DrawMesh computes them
+        Matrix model = MatrixMultiply(item.transform, rlGetMatrixTransform());
+        if (locs[SHADER_LOC_MATRIX_MODEL] != -1) rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_MODEL], model);
+        if (locs[SHADER_LOC_MATRIX_NORMAL] != -1) rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_NORMAL], MatrixTranspose(MatrixInvert(model)));
+        rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_MVP], MatrixMultiply(MatrixMultiply(model, view), projection));
+        
+        if (item.mesh->indices != nullptr) {
+            rlDrawVertexArrayElements(0, item.mesh->triangleCount * 3, 0);
+        } else {
+            rlDrawVertexArray(0, item.mesh->vertexCount);
+        }
+        bound = &item;
+        drawCalls++;
+    }
+    
+    if (bound) {
+        rlActiveTextureSlot(0);
+        rlDisableTexture();
+        rlDisableVertexArray();
+        rlDisableShader();
+    }
+    return drawCalls;
+}
@@ -0,0 +1,53 @@
+// render_queue.h - Sorted mesh draw submission with state-change counting
+#pragma once
+
+#include "raylib.h"
+#include <cstdint>
+#include <map>
+#include <vector>
+
+// Passes run in order; items in a pass are sorted by that pass's key layout
+const int RENDER_PASS_OPAQUE = 0;         // Grouped by shader, material, mesh, then front-to-back
+const int RENDER_PASS_TRANSPARENT = 1;    // Back-to-front, then by state
+
+const float RENDER_QUEUE_MAX_DEPTH = 1000.0f;  // Camera distance mapped to the key's depth bits
+
+// One recorded DrawMesh call. The mesh and the material's maps must outlive Draw.
+struct RenderItem {
+    uint64_t key;
+    const Mesh* mesh;
+    Material material;
+    Matrix transform;
+};
+
+// Shader, material and vertex array binds needed to draw a sequence of items
+struct RenderStateChanges {
+    int shaders, materials, meshes;
+    
+    int Total() const { return shaders + materials + meshes; }
+};
+
+// Draw calls are submitted with a sort key (pass, shader, material, mesh, depth) and run
+// in a separate step, so items sharing state are drawn together and each bind is made
+// once per run instead of once per object as DrawModel does.
+struct RenderQueue {
+    std::vector<RenderItem> items;
+    std::map<const MaterialMap*, int> materialIds;  // Small stable ids for the key
+    Vector3 eye = { 0 };
+    bool sorting = true;            // False draws in submission order for comparison
+    
+    RenderStateChanges submitted = {};  // Binds the submission order would need
+    RenderStateChanges executed = {};   // Binds actually made by Draw this frame
+    
+    void Begin(Vector3 cameraPosition);
+    void Submit(int pass, const Mesh& mesh, const Material& material, Matrix transform);
+    
+    // DrawModel equivalents: every mesh with its own material, or all with one override
+    void SubmitModel(int pass, const Model& model, Vector3 position, float scale);
+    void SubmitModel(int pass, const Model& model, const Material& material, Vector3 position, float scale);
+    
+    void Sort();
+    
+    // Draw one pass; call between BeginMode3D/EndMode3D after Sort. Returns the draw calls.
+    int Draw(int pass);
+};
@@ -3,6 +3,22 @@
 
 #include "raylib.h"
 #include "raymath.h"
+#include "rlgl.h"
+#include "frustum.h"
+#include "grid_mesh.h"
+#include "hud_panel.h"
+#include "frame_graph.h"
+#include "mesh_lod.h"
+#include "mesh_cache.h"
+#include "instance_batch.h"
+#include "occlusion.h"
+#include "model_variants.h"
+#include "render_queue.h"
+#include "frame_pipeline.h"
+#include "gpu_timer.h"
+#include "dynamic_resolution.h"
+#include "moebius_post.h"
+#include "post_chain.h"
 #include <cmath>
 #include <deque>
 
@@ -40,6 +56,106 @@ struct PerfStats {
     }
 };
 
+// Frustum culling counts for the debug overlay
+struct CullStats {
+    int drawn, culled, occluded;
+    
+    // Count the object and pass through whether it should be drawn
+    bool Test(bool visible) {
+        if (visible) drawn++; else culled++;
+        return visible;
+    }
+    
+    // Occlusion stage for an object that passed Test: hidden ones move from drawn to occluded
+    bool Occlusion(bool visible) {
+        if (!visible) { drawn--; occluded++; }
+        return visible;
+    }
+};
+
+// One frame of input and settings, sampled on the main thread for the simulation
+struct SceneInput {
+    Vector2 mouseDelta;
+    bool forward, back, left, right, up, down, fast;   // W S A D E Q, Shift
+    float frameTime;
+    bool paused;                // Menu open: no movement
+    float mouseSens, moveSpeed, fov;
+    float aspect;
+    int screenHeight;           // Scene render height, for LOD
+    int level;
+    bool water, culling, lod, occlusion, sorting;
+};
+
+// Everything the main thread draws from one simulation step
+struct SceneFrame {
+    Camera3D camera;
+    Vector3 position;
+    float yaw, pitch;
+    float time;
+    RenderQueue queue;          // Models, sorted
+    InstanceList instances;     // Level 3's instanced objects
+    CullStats cull;
+    int vertices, fullVertices; // LOD counts
+};
+
+const float WATER_WAVE_HEIGHT = 0.25f;  // Max vertical offset added by water.vs
+
+// Model bounds translated to position and scaled (no rotation)
+static BoundingBox PlaceBounds(BoundingBox local, Vector3 position, float scale) {
+    return {
+        Vector3Add(Vector3Scale(local.min, scale), position),
+        Vector3Add(Vector3Scale(local.max, scale), position)
+    };
+}
+
+// Null frustum draws everything
+static bool BoxVisible(const Frustum* frustum, BoundingBox local, Vector3 position, float scale) {
+    return !frustum || FrustumContainsBox(*frustum, PlaceBounds(local, position, scale));
+}
+
+static bool SphereVisible(const Frustum* frustum, Vector3 center, float radius) {
+    return !frustum || FrustumContainsSphere(*frustum, center, radius);
+}
+
+// Null occlusion buffer hides nothing
+static bool BoxUnoccluded(const OcclusionBuffer* occlusion, BoundingBox local, Vector3 position, float scale) {
+    return !occlusion || occlusion->BoxVisible(PlaceBounds(local, position, scale));
+}
+
+static bool SphereUnoccluded(const OcclusionBuffer* occlusion, Vector3 center, float radius) {
+    Vector3 extent = { radius, radius, radius };
+    return !occlusion || occlusion->BoxVisible({ Vector3Subtract(center, extent), Vector3Add(center, extent) });
+}
+
+// Water planes are one mesh drawn either plain or through the water shader
+const int WATER_VARIANT_PLAIN = 0;
+const int WATER_VARIANT_SHADED = 1;
+
+static void LoadWater(ModelVariants& water, float size, int resolution, Color color, Shader shader) {
+    water.Load(LoadModelFromMesh(GenMeshPlane(size, size, resolution, resolution)));
+    water.materials[WATER_VARIANT_PLAIN].maps[MATERIAL_MAP_DIFFUSE].color = color;
+    
+    Material shaded = LoadMaterialDefault();
+    shaded.shader = shader;
+    shaded.maps[MATERIAL_MAP_DIFFUSE].color = color;
+    water.AddVariant(shaded);
+}
+
+// The water shader writes alpha below 1, so the shaded variant is drawn in the transparent pass
+static void SubmitWater(RenderQueue& queue, const ModelVariants& water, bool shaded, Vector3 position) {
+    int variant = shaded ? WATER_VARIANT_SHADED : WATER_VARIANT_PLAIN;
+    int pass = shaded ? RENDER_PASS_TRANSPARENT : RENDER_PASS_OPAQUE;
+    queue.SubmitModel(pass, water.model, water.materials[variant], position, 1.0f);
+}
+
+// Water planes are flat on the CPU; pad them by the wave height
+static BoundingBox WaterBounds(const ModelVariants& water) {
+    BoundingBox bounds = GetModelBoundingBox(water.model);
+    bounds.min.y -= WATER_WAVE_HEIGHT;
+    bounds.max.y += WATER_WAVE_HEIGHT;
+    return bounds;
+}
+
 int main() {
     const int screenWidth = 1280;
     const int screenHeight = 720;
@@ -49,10 +165,10 @@ int main() {
     SetExitKey(KEY_NULL);
     SetTargetFPS(0);
     
-    // Player state
+    // Player state (advanced by the simulation)
     Vector3 position = { 8.0f, 6.0f, 8.0f };
     float yaw = -135.0f, pitch = -15.0f;
-    float moveSpeed = 10.0f, mouseSens = 0.1f, fov = 70.0f;
+    float moveSpeed = 10.0f, mouseSens = 0.1f, fov = 70.0f;   // Menu settings (main thread)
     
     Camera3D camera = { 0 };
     camera.position = position;
@@ -61,39 +177,76 @@ int main() {
     camera.fovy = fov;
     camera.projection = CAMERA_PERSPECTIVE;
     
+    // The scene is rendered into the top-left of a full-size target at dynres.scale and
+    // stretched to the screen by the post pass; the target only reallocates on resize
     RenderTexture2D target = LoadRenderTexture(screenWidth, screenHeight);
+    SetTextureFilter(target.texture, TEXTURE_FILTER_BILINEAR);
+    DynamicResolution dynres;       // F4
+    GpuTimer sceneTimer;            // Post passes time themselves (spans can't nest)
+    sceneTimer.Load();
+    float postMs = 0.0f;            // Last post total with every step measured
+    
+    // Ground grid shared by all levels, uploaded once
+    GridMesh grid;
+    grid.Load(20, 1.0f);
+    
+    // Overlays are drawn into textures and only redrawn when their contents change
+    HudPanel debugPanel, levelPanel;
+    debugPanel.Load(300, 408, HUD_REFRESH_INTERVAL);
+    levelPanel.Load(220, 50, 0.0f);
+    
+    // Frame graph history lives on the GPU and is drawn live over the debug panel
+    FrameGraph frameGraph;
+    frameGraph.Load();
+    Rectangle graphRect = { 0 };    // Graph area inside debugPanel
     
     // --- SHADERS ---
     Shader waterShader = LoadShader("resources/shaders/water.vs", "resources/shaders/water.fs");
-    Shader moebiusShader = LoadShader("resources/shaders/moebius.vs", "resources/shaders/moebius.fs");
+    MoebiusPost moebius;            // F5 cycles how it runs
+    moebius.Load();
+    
+    // Post chain in toggle key order; T (water) is a material, not a post pass
+    PostChain post;                 // F2 toggles fusion
+    post.Load();
+    const int moebiusPass = post.AddCustom("Moebius",
+        [&](Texture2D src, int width, int height) { moebius.Prepare(src, width, height); },
+        [&](Texture2D src, int width, int height, Rectangle dest) { moebius.Draw(src, width, height, dest); });
+    post.AddPoint("Grade", "grade", "resources/shaders/post_grade.glsl");
+    post.AddShader("Aberration", "resources/shaders/post_aberration.fs");
+    post.AddPoint("Vignette", "vignette", "resources/shaders/post_vignette.glsl");
+    post.AddPoint("Grain", "grain", "resources/shaders/post_grain.glsl");
+    const int postKeys[] = { KEY_Y, KEY_U, KEY_I, KEY_O, KEY_P };
+    const char postKeyNames[] = "YUIOP";
     
     int waterTimeLoc = GetShaderLocation(waterShader, "time");
     int waterViewPosLoc = GetShaderLocation(waterShader, "viewPos");
-    int moebiusResLoc = GetShaderLocation(moebiusShader, "resolution");
-    int moebiusTimeLoc = GetShaderLocation(moebiusShader, "time");
     
     // --- LEVEL 1: Island ---
     Model terrain1 = LoadModelFromMesh(GenMeshCube(6.0f, 1.0f, 6.0f));
-    Model water1 = LoadModelFromMesh(GenMeshPlane(20.0f, 20.0f, 32, 32));
-    Model water1_plain = LoadModelFromMesh(GenMeshPlane(20.0f, 20.0f, 32, 32));
+    ModelVariants water1;
+    LoadWater(water1, 20.0f, 32, (Color){ 100, 150, 200, 255 }, waterShader);
     Model rock1a = LoadModelFromMesh(GenMeshSphere(0.8f, 8, 8));
     Model rock1b = LoadModelFromMesh(GenMeshSphere(0.5f, 8, 8));
     Model tree1 = LoadModelFromMesh(GenMeshCylinder(0.3f, 2.0f, 8));
     Model foliage1 = LoadModelFromMesh(GenMeshSphere(1.2f, 8, 8));
     
     terrain1.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 180, 140, 100, 255 };
-    water1.materials[0].shader = waterShader;
-    water1.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 100, 150, 200, 255 };
-    water1_plain.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 100, 150, 200, 255 };
     rock1a.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 100, 100, 110, 255 };
     rock1b.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 90, 85, 95, 255 };
     tree1.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 100, 70, 50, 255 };
     foliage1.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 80, 150, 80, 255 };
     
+    BoundingBox terrain1Bounds = GetModelBoundingBox(terrain1);
+    BoundingBox water1Bounds = WaterBounds(water1);
+    BoundingBox rock1aBounds = GetModelBoundingBox(rock1a);
+    BoundingBox rock1bBounds = GetModelBoundingBox(rock1b);
+    BoundingBox tree1Bounds = GetModelBoundingBox(tree1);
+    BoundingBox foliage1Bounds = GetModelBoundingBox(foliage1);
+    
     // --- LEVEL 2: Ruins ---
     Model terrain2 = LoadModelFromMesh(GenMeshCube(8.0f, 1.5f, 8.0f));
-    Model water2 = LoadModelFromMesh(GenMeshPlane(25.0f, 25.0f, 32, 32));
-    Model water2_plain = LoadModelFromMesh(GenMeshPlane(25.0f, 25.0f, 32, 32));
+    ModelVariants water2;
+    LoadWater(water2, 25.0f, 32, (Color){ 100, 150, 200, 255 }, waterShader);
     Model pillar1 = LoadModelFromMesh(GenMeshCylinder(0.5f, 4.0f, 8));
     Model pillar2 = LoadModelFromMesh(GenMeshCylinder(0.5f, 3.5f, 8));
     Model pillar3 = LoadModelFromMesh(GenMeshCylinder(0.4f, 3.0f, 8));
@@ -102,9 +255,6 @@ int main() {
     Model altar = LoadModelFromMesh(GenMeshCube(2.0f, 0.5f, 2.0f));
     
     terrain2.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 160, 130, 100, 255 };
-    water2.materials[0].shader = waterShader;
-    water2.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 100, 150, 200, 255 };
-    water2_plain.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 100, 150, 200, 255 };
     pillar1.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 200, 180, 160, 255 };
     pillar2.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 190, 170, 150, 255 };
     pillar3.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 180, 160, 140, 255 };
@@ -112,31 +262,54 @@ int main() {
     orb.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 220, 180, 80, 255 };
     altar.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 120, 110, 100, 255 };
     
+    BoundingBox terrain2Bounds = GetModelBoundingBox(terrain2);
+    BoundingBox water2Bounds = WaterBounds(water2);
+    BoundingBox pillar1Bounds = GetModelBoundingBox(pillar1);
+    BoundingBox pillar2Bounds = GetModelBoundingBox(pillar2);
+    BoundingBox pillar3Bounds = GetModelBoundingBox(pillar3);
+    BoundingBox pillar4Bounds = GetModelBoundingBox(pillar4);
+    BoundingBox orbBounds = GetModelBoundingBox(orb);
+    BoundingBox altarBounds = GetModelBoundingBox(altar);
+    
     // --- LEVEL 3: Stress Test (demanding scene) ---
+    // Repeated primitives share one GPU mesh per generator call and are drawn instanced,
+    // one draw per mesh, with colour and transform per instance
+    MeshCache meshCache;
+    InstanceBatch instanceBatch;
+    instanceBatch.Load();
+    
     // Use a knot mesh as "teapot" stand-in (OBJ loading crashes)
-    Model teapot = LoadModelFromMesh(GenMeshKnot(1.0f, 0.4f, 128, 64));
-    teapot.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 200, 160, 120, 255 };
+    // Level 3's curved models are LOD chains, picked per instance by projected size
+    LodModel teapot = LoadLodKnot(meshCache, 1.0f, 0.4f, 128, 64);
+    Color teapotColor = { 200, 160, 120, 255 };
+    int teapotLod[7] = {};              // Central teapot, then the orbiting ones
     
-    Model water3 = LoadModelFromMesh(GenMeshPlane(60.0f, 60.0f, 64, 64));  // Bigger, more detailed water
-    Model water3_plain = LoadModelFromMesh(GenMeshPlane(60.0f, 60.0f, 64, 64));
-    water3.materials[0].shader = waterShader;
-    water3.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 80, 130, 180, 255 };
-    water3_plain.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 80, 130, 180, 255 };
+    ModelVariants water3;
+    LoadWater(water3, 60.0f, 64, (Color){ 80, 130, 180, 255 }, waterShader);  // Bigger, more detailed water
     
     // Ground platforms
     Model platform3 = LoadModelFromMesh(GenMeshCube(15.0f, 2.0f, 15.0f));
     platform3.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 140, 120, 100, 255 };
     
+    // Spinning models are culled by the sphere that contains them at any angle
+    float teapotRadius = teapot.radius;
+    BoundingBox water3Bounds = WaterBounds(water3);
+    BoundingBox platform3Bounds = GetModelBoundingBox(platform3);
+    
     // Many spheres for stress
     const int NUM_SPHERES = 50;
-    Model spheres3[NUM_SPHERES];
+    LodModel spheres3[NUM_SPHERES];
+    int sphereLod3[NUM_SPHERES] = {};
     Vector3 spherePos3[NUM_SPHERES];
     float sphereSpeed3[NUM_SPHERES];
     float spherePhase3[NUM_SPHERES];
+    float sphereRadius3[NUM_SPHERES];
+    Color sphereColor3[NUM_SPHERES];
     for (int i = 0; i < NUM_SPHERES; i++) {
         float radius = 0.3f + (float)(i % 5) * 0.15f;
-        spheres3[i] = LoadModelFromMesh(GenMeshSphere(radius, 16, 16));
-        spheres3[i].materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 
+        spheres3[i] = LoadLodSphere(meshCache, radius, 16, 16);
+        sphereRadius3[i] = radius;
+        sphereColor3[i] = (Color){ 
             (unsigned char)(100 + i * 3), 
             (unsigned char)(150 - i * 2), 
             (unsigned char)(200 - i), 
@@ -152,13 +325,16 @@ int main() {
     
     // Many cubes
     const int NUM_CUBES = 40;
-    Model cubes3[NUM_CUBES];
+    Mesh cubes3[NUM_CUBES];
+    Color cubeColor3[NUM_CUBES];
     Vector3 cubePos3[NUM_CUBES];
     float cubeRotSpeed3[NUM_CUBES];
+    float cubeRadius3[NUM_CUBES];
     for (int i = 0; i < NUM_CUBES; i++) {
         float size = 0.5f + (float)(i % 4) * 0.3f;
-        cubes3[i] = LoadModelFromMesh(GenMeshCube(size, size, size));
-        cubes3[i].materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 
+        cubes3[i] = meshCache.Cube(size, size, size);
+        cubeRadius3[i] = size * 0.5f * sqrtf(3.0f);
+        cubeColor3[i] = (Color){ 
             (unsigned char)(200 - i * 2), 
             (unsigned char)(100 + i * 2), 
             (unsigned char)(80 + i), 
@@ -172,23 +348,35 @@ int main() {
     
     // Pillars/columns
     const int NUM_PILLARS3 = 16;
-    Model pillars3[NUM_PILLARS3];
+    LodModel pillars3[NUM_PILLARS3];
+    int pillarLod3[NUM_PILLARS3] = {};
+    Color pillarColor3 = { 180, 170, 160, 255 };
     Vector3 pillarPos3[NUM_PILLARS3];
+    BoundingBox pillarBounds3[NUM_PILLARS3];
+    BoundingBox pillarOccluders3[NUM_PILLARS3];
     for (int i = 0; i < NUM_PILLARS3; i++) {
         float height = 4.0f + (float)(i % 3) * 2.0f;
-        pillars3[i] = LoadModelFromMesh(GenMeshCylinder(0.6f, height, 12));
-        pillars3[i].materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 180, 170, 160, 255 };
+        pillars3[i] = LoadLodCylinder(meshCache, 0.6f, height, 12);
+        pillarBounds3[i] = GetMeshBoundingBox(pillars3[i].levels[0]);
         float angle = (float)i / NUM_PILLARS3 * PI * 2.0f;
         pillarPos3[i] = { cosf(angle) * 18.0f, height / 2.0f + 1.0f, sinf(angle) * 18.0f };
+        // Occluder: square inside the coarsest LOD's hexagon (inradius r cos 30deg, over sqrt 2)
+        float inner = 0.6f * cosf(PI / 6.0f) * 0.7071f;
+        BoundingBox core = { { -inner, pillarBounds3[i].min.y, -inner }, { inner, pillarBounds3[i].max.y, inner } };
+        pillarOccluders3[i] = PlaceBounds(core, pillarPos3[i], 1.0f);
     }
     
     // Torus rings
     const int NUM_TORUS = 8;
-    Model torus3[NUM_TORUS];
+    LodModel torus3[NUM_TORUS];
+    int torusLod3[NUM_TORUS] = {};
+    Color torusColor3[NUM_TORUS];
     Vector3 torusPos3[NUM_TORUS];
+    float torusRadius3[NUM_TORUS];
     for (int i = 0; i < NUM_TORUS; i++) {
-        torus3[i] = LoadModelFromMesh(GenMeshTorus(0.3f, 1.2f + (float)(i % 3) * 0.3f, 16, 16));
-        torus3[i].materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 
+        torus3[i] = LoadLodTorus(meshCache, 0.3f, 1.2f + (float)(i % 3) * 0.3f, 16, 16);
+        torusRadius3[i] = torus3[i].radius;
+        torusColor3[i] = (Color){ 
             (unsigned char)(220 - i * 10), 
             (unsigned char)(180 + i * 5), 
             (unsigned char)(100), 
@@ -200,11 +388,15 @@ int main() {
     
     // Cones
     const int NUM_CONES = 12;
-    Model cones3[NUM_CONES];
+    LodModel cones3[NUM_CONES];
+    int coneLod3[NUM_CONES] = {};
+    Color coneColor3[NUM_CONES];
     Vector3 conePos3[NUM_CONES];
+    BoundingBox coneBounds3[NUM_CONES];
     for (int i = 0; i < NUM_CONES; i++) {
-        cones3[i] = LoadModelFromMesh(GenMeshCone(0.5f + (float)(i % 3) * 0.2f, 1.5f, 8));
-        cones3[i].materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 
+        cones3[i] = LoadLodCone(meshCache, 0.5f + (float)(i % 3) * 0.2f, 1.5f, 8);
+        coneBounds3[i] = GetMeshBoundingBox(cones3[i].levels[0]);
+        coneColor3[i] = (Color){ 
             (unsigned char)(150 + i * 5), 
             (unsigned char)(80 + i * 3), 
             (unsigned char)(60 + i * 4), 
@@ -215,28 +407,219 @@ int main() {
         conePos3[i] = { cosf(angle) * dist, 1.75f, sinf(angle) * dist };
     }
     
+    TraceLog(LOG_INFO, "MeshCache: %d meshes for %d requests", (int)meshCache.meshes.size(), meshCache.requests);
+    
     DisableCursor();
     
     // State
     bool showMenu = false;
     bool showDebug = true;
     bool showFps = true;
+    bool cullingEnabled = true;  // F6
+    bool lodEnabled = true;      // F7
+    bool occlusionEnabled = true;  // F8
+    int instanceDraws = 0;       // F9 toggles instanceBatch.instancing
+    bool sortingEnabled = true;  // F10
+    int queueDraws = 0;
+    float submitMs = 0.0f;       // Main thread: drawing from the frame handoff to EndDrawing
     int currentLevel = 1;
-    float time = 0.0f;
     PerfStats perf = {};
     
-    // Shader toggles: T, Y, U, I, O, P (6 slots for future shaders)
+    // Shader toggles: T for water, Y-P for the post passes
     bool waterEnabled = true;    // T
-    bool moebiusEnabled = true;  // Y
-    bool shader3 = false;        // U - placeholder
-    bool shader4 = false;        // I - placeholder
-    bool shader5 = false;        // O - placeholder
-    bool shader6 = false;        // P - placeholder
+    bool& moebiusEnabled = post.passes[moebiusPass].enabled;   // Y
+    moebiusEnabled = true;
+    
+    // --- SIMULATION ---
+    // Movement, culling, LOD selection, occlusion and draw submission run on their own
+    // thread one frame ahead of drawing (F11 switches to serial for comparison). Each step
+    // reads simInput, copied while the thread is idle, and fills one frame slot; only the
+    // simulation touches the player state, time, LOD choices and occlusion buffer.
+    SceneInput simInput = {};
+    SceneFrame frames[FRAME_PIPELINE_SLOTS];
+    float time = 0.0f;
+    LodView lod;
+    OcclusionBuffer occlusion;
+    
+    auto simulate = [&](int slot) {
+        const SceneInput& in = simInput;
+        SceneFrame& frame = frames[slot];
+        time += in.frameTime;
+        
+        // --- NOCLIP MOVEMENT ---
+        if (!in.paused) {
+            yaw += in.mouseDelta.x * in.mouseSens;
+            pitch -= in.mouseDelta.y * in.mouseSens;
+            if (pitch > 89.0f) pitch = 89.0f;
+            if (pitch < -89.0f) pitch = -89.0f;
+            
+            Vector3 forward = {
+                cosf(DEG2RAD * yaw) * cosf(DEG2RAD * pitch),
+                sinf(DEG2RAD * pitch),
+                sinf(DEG2RAD * yaw) * cosf(DEG2RAD * pitch)
+            };
+            forward = Vector3Normalize(forward);
+            Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, {0, 1, 0}));
+            Vector3 up = { 0, 1, 0 };
+            
+            Vector3 move = { 0, 0, 0 };
+            if (in.forward) move = Vector3Add(move, forward);
+            if (in.back) move = Vector3Subtract(move, forward);
+            if (in.left) move = Vector3Subtract(move, right);
+            if (in.right) move = Vector3Add(move, right);
+            if (in.up) move = Vector3Add(move, up);
+            if (in.down) move = Vector3Subtract(move, up);
+            
+            float speed = in.moveSpeed;
+            if (in.fast) speed *= 2.5f;
+            
+            if (Vector3Length(move) > 0) {
+                move = Vector3Normalize(move);
+                position = Vector3Add(position, Vector3Scale(move, speed * in.frameTime));
+            }
+            
+            camera.position = position;
+            camera.target = Vector3Add(position, forward);
+        }
+        
+        camera.fovy = in.fov;
+        frame.camera = camera;
+        frame.position = position;
+        frame.yaw = yaw;
+        frame.pitch = pitch;
+        frame.time = time;
+        
+        // --- FRUSTUM ---
+        // Same projection BeginMode3D builds for the render target
+        Matrix viewProjection = GetCameraViewProjection(camera, in.aspect);
+        Frustum frustum = FrustumFromMatrix(viewProjection);
+        const Frustum* view = in.culling ? &frustum : nullptr;
+        CullStats& cull = frame.cull;
+        cull = {};
+        lod.Begin(camera, in.screenHeight, in.lod);
+        
+        // --- OCCLUSION ---
+        // Level 3's platform and pillars are rasterized into a small depth pyramid on the CPU;
+        // objects that pass the frustum test are then skipped if they are behind them
+        const OcclusionBuffer* occluders = nullptr;
+        if (in.level == 3 && in.occlusion) {
+            occlusion.Begin(viewProjection);
+            occlusion.AddBox(platform3Bounds);
+            for (int i = 0; i < NUM_PILLARS3; i++) occlusion.AddBox(pillarOccluders3[i]);
+            occlusion.Finish();
+            occluders = &occlusion;
+        }
+        
+        // --- SUBMISSION ---
+        // Models go to the frame's render queue, sorted here by pass and state; Level 3's
+        // instanced objects go to its instance list. Both are drawn on the main thread.
+        RenderQueue& queue = frame.queue;
+        InstanceList& instances = frame.instances;
+        queue.sorting = in.sorting;
+        queue.Begin(camera.position);
+        instances.Begin();
+        
+        if (in.level == 1) {
+            Vector3 terrainPos = { 0, 0.5f, 0 }, rockAPos = { -1.5f, 1.0f, 1.0f }, rockBPos = { 2.0f, 1.0f, -1.5f };
+            Vector3 treePos = { 0.5f, 2.0f, 0.5f }, foliagePos = { 0.5f, 3.5f, 0.5f }, waterPos = { 0, -0.2f, 0 };
+            if (cull.Test(BoxVisible(view, terrain1Bounds, terrainPos, 1.0f))) queue.SubmitModel(RENDER_PASS_OPAQUE, terrain1, terrainPos, 1.0f);
+            if (cull.Test(BoxVisible(view, rock1aBounds, rockAPos, 1.0f))) queue.SubmitModel(RENDER_PASS_OPAQUE, rock1a, rockAPos, 1.0f);
+            if (cull.Test(BoxVisible(view, rock1bBounds, rockBPos, 1.0f))) queue.SubmitModel(RENDER_PASS_OPAQUE, rock1b, rockBPos, 1.0f);
+            if (cull.Test(BoxVisible(view, tree1Bounds, treePos, 1.0f))) queue.SubmitModel(RENDER_PASS_OPAQUE, tree1, treePos, 1.0f);
+            if (cull.Test(BoxVisible(view, foliage1Bounds, foliagePos, 1.0f))) queue.SubmitModel(RENDER_PASS_OPAQUE, foliage1, foliagePos, 1.0f);
+            // Water - shader or plain variant of the same mesh
+            if (cull.Test(BoxVisible(view, water1Bounds, waterPos, 1.0f))) SubmitWater(queue, water1, in.water, waterPos);
+        } else if (in.level == 2) {
+            Vector3 terrainPos = { 0, 0.25f, 0 }, altarPos = { 0, 1.25f, 0 }, waterPos = { 0, -0.3f, 0 };
+            Vector3 pillarPos[4] = { { -2.5f, 3.0f, -2.5f }, { 2.5f, 2.75f, -2.5f }, { -2.5f, 2.5f, 2.5f }, { 2.5f, 2.25f, 2.5f } };
+            if (cull.Test(BoxVisible(view, terrain2Bounds, terrainPos, 1.0f))) queue.SubmitModel(RENDER_PASS_OPAQUE, terrain2, terrainPos, 1.0f);
+            if (cull.Test(BoxVisible(view, pillar1Bounds, pillarPos[0], 1.0f))) queue.SubmitModel(RENDER_PASS_OPAQUE, pillar1, pillarPos[0], 1.0f);
+            if (cull.Test(BoxVisible(view, pillar2Bounds, pillarPos[1], 1.0f))) queue.SubmitModel(RENDER_PASS_OPAQUE, pillar2, pillarPos[1], 1.0f);
+            if (cull.Test(BoxVisible(view, pillar3Bounds, pillarPos[2], 1.0f))) queue.SubmitModel(RENDER_PASS_OPAQUE, pillar3, pillarPos[2], 1.0f);
+            if (cull.Test(BoxVisible(view, pillar4Bounds, pillarPos[3], 1.0f))) queue.SubmitModel(RENDER_PASS_OPAQUE, pillar4, pillarPos[3], 1.0f);
+            if (cull.Test(BoxVisible(view, altarBounds, altarPos, 1.0f))) queue.SubmitModel(RENDER_PASS_OPAQUE, altar, altarPos, 1.0f);
+            float bob = sinf(time * 2.0f) * 0.3f;
+            Vector3 orbPos = { 0, 3.0f + bob, 0 };
+            if (cull.Test(BoxVisible(view, orbBounds, orbPos, 1.0f))) queue.SubmitModel(RENDER_PASS_OPAQUE, orb, orbPos, 1.0f);
+            // Water - shader or plain variant of the same mesh
+            if (cull.Test(BoxVisible(view, water2Bounds, waterPos, 1.0f))) SubmitWater(queue, water2, in.water, waterPos);
+        } else if (in.level == 3) {
+            // --- STRESS TEST SCENE ---
+            if (cull.Test(BoxVisible(view, platform3Bounds, (Vector3){ 0, 0, 0 }, 1.0f))) {
+                queue.SubmitModel(RENDER_PASS_OPAQUE, platform3, (Vector3){ 0, 0, 0 }, 1.0f);
+            }
+            
+            // Central spinning teapot
+            if (cull.Test(SphereVisible(view, (Vector3){ 0, 3.0f, 0 }, teapotRadius * 2.0f)) &&
+                cull.Occlusion(SphereUnoccluded(occluders, (Vector3){ 0, 3.0f, 0 }, teapotRadius * 2.0f))) {
+                Matrix transform = InstanceTransform((Vector3){ 0, 3.0f, 0 }, (Vector3){ 0, 1, 0 }, time * 30.0f, (Vector3){ 2.0f, 2.0f, 2.0f });
+                instances.Add(lod.Pick(teapot, teapotLod[0], (Vector3){ 0, 3.0f, 0 }, 2.0f), transform, teapotColor);
+            }
+            
+            // Orbiting teapots
+            for (int i = 0; i < 6; i++) {
+                float angle = time * 0.5f + (float)i * PI / 3.0f;
+                float dist = 6.0f;
+                Vector3 pos = { cosf(angle) * dist, 2.5f + sinf(time * 2.0f + i) * 0.5f, sinf(angle) * dist };
+                if (!cull.Test(SphereVisible(view, pos, teapotRadius)) || !cull.Occlusion(SphereUnoccluded(occluders, pos, teapotRadius))) continue;
+                Matrix transform = InstanceTransform(pos, (Vector3){ 0, 1, 0 }, -time * 45.0f, (Vector3){ 1.0f, 1.0f, 1.0f });
+                instances.Add(lod.Pick(teapot, teapotLod[1 + i], pos, 1.0f), transform, teapotColor);
+            }
+            
+            // Bouncing spheres
+            for (int i = 0; i < NUM_SPHERES; i++) {
+                float bounce = fabsf(sinf(time * sphereSpeed3[i] + spherePhase3[i])) * 2.0f;
+                Vector3 pos = spherePos3[i];
+                pos.y += bounce;
+                if (!cull.Test(SphereVisible(view, pos, sphereRadius3[i])) || !cull.Occlusion(SphereUnoccluded(occluders, pos, sphereRadius3[i]))) continue;
+                instances.Add(lod.Pick(spheres3[i], sphereLod3[i], pos, 1.0f), MatrixTranslate(pos.x, pos.y, pos.z), sphereColor3[i]);
+            }
+            
+            // Rotating cubes
+            for (int i = 0; i < NUM_CUBES; i++) {
+                if (!cull.Test(SphereVisible(view, cubePos3[i], cubeRadius3[i])) || !cull.Occlusion(SphereUnoccluded(occluders, cubePos3[i], cubeRadius3[i]))) continue;
+                Matrix transform = InstanceTransform(cubePos3[i], (Vector3){ 1, 1, 0 }, time * cubeRotSpeed3[i], (Vector3){ 1, 1, 1 });
+                instances.Add(cubes3[i], transform, cubeColor3[i]);
+            }
+            
+            // Static pillars
+            for (int i = 0; i < NUM_PILLARS3; i++) {
+                if (!cull.Test(BoxVisible(view, pillarBounds3[i], pillarPos3[i], 1.0f)) || !cull.Occlusion(BoxUnoccluded(occluders, pillarBounds3[i], pillarPos3[i], 1.0f))) continue;
+                Vector3 pos = pillarPos3[i];
+                instances.Add(lod.Pick(pillars3[i], pillarLod3[i], pos, 1.0f), MatrixTranslate(pos.x, pos.y, pos.z), pillarColor3);
+            }
+            
+            // Spinning torus rings
+            for (int i = 0; i < NUM_TORUS; i++) {
+                Vector3 pos = torusPos3[i];
+                pos.y += sinf(time * 1.5f + (float)i) * 1.0f;
+                if (!cull.Test(SphereVisible(view, pos, torusRadius3[i])) || !cull.Occlusion(SphereUnoccluded(occluders, pos, torusRadius3[i]))) continue;
+                Matrix transform = InstanceTransform(pos, (Vector3){ 1, 0, 0 }, time * 60.0f + i * 45.0f, (Vector3){ 1, 1, 1 });
+                instances.Add(lod.Pick(torus3[i], torusLod3[i], pos, 1.0f), transform, torusColor3[i]);
+            }
+            
+            // Static cones
+            for (int i = 0; i < NUM_CONES; i++) {
+                if (!cull.Test(BoxVisible(view, coneBounds3[i], conePos3[i], 1.0f)) || !cull.Occlusion(BoxUnoccluded(occluders, coneBounds3[i], conePos3[i], 1.0f))) continue;
+                Vector3 pos = conePos3[i];
+                instances.Add(lod.Pick(cones3[i], coneLod3[i], pos, 1.0f), MatrixTranslate(pos.x, pos.y, pos.z), coneColor3[i]);
+            }
+            
+            // Water
+            if (cull.Test(BoxVisible(view, water3Bounds, (Vector3){ 0, -0.5f, 0 }, 1.0f))) SubmitWater(queue, water3, in.water, (Vector3){ 0, -0.5f, 0 });
+        }
+        
+        queue.Sort();
+        frame.vertices = lod.vertices;
+        frame.fullVertices = lod.fullVertices;
+    };
+    
+    FramePipeline pipeline;
+    pipeline.Start(simulate);
     
     while (!WindowShouldClose()) {
-        float dt = GetFrameTime();
-        time += dt;
         perf.Update();
+        frameGraph.Push(perf.ms);
         
         int w = GetRenderWidth();
         int h = GetRenderHeight();
@@ -244,192 +627,144 @@ int main() {
         if (target.texture.width != w || target.texture.height != h) {
             UnloadRenderTexture(target);
             target = LoadRenderTexture(w, h);
+            SetTextureFilter(target.texture, TEXTURE_FILTER_BILINEAR);
         }
         
+        // Scale from the GPU time of recent frames (read back a few frames late). After a post
+        // toggle the new steps read 0 until measured, so the last full total stands in.
+        if (post.Measured()) postMs = post.TotalMs();
+        dynres.Update(sceneTimer.ready ? sceneTimer.ms + postMs : perf.ms);
+        int renderWidth = dynres.Scaled(w);
+        int renderHeight = dynres.Scaled(h);
+        
         // --- INPUT ---
         if (IsKeyPressed(KEY_ESCAPE)) {
             showMenu = !showMenu;
             if (showMenu) EnableCursor(); else DisableCursor();
         }
+        if (IsKeyPressed(KEY_F2)) post.fusion = !post.fusion;
         if (IsKeyPressed(KEY_F3)) showDebug = !showDebug;
+        if (IsKeyPressed(KEY_F4)) dynres.enabled = !dynres.enabled;
+        if (IsKeyPressed(KEY_F5)) moebius.CycleMode();
+        if (IsKeyPressed(KEY_F6)) cullingEnabled = !cullingEnabled;
+        if (IsKeyPressed(KEY_F7)) lodEnabled = !lodEnabled;
+        if (IsKeyPressed(KEY_F8)) occlusionEnabled = !occlusionEnabled;
+        if (IsKeyPressed(KEY_F9)) instanceBatch.instancing = !instanceBatch.instancing;
+        if (IsKeyPressed(KEY_F10)) sortingEnabled = !sortingEnabled;
+        if (IsKeyPressed(KEY_F11)) pipeline.threaded = !pipeline.threaded;
         if (IsKeyPressed(KEY_ONE)) currentLevel = 1;
         if (IsKeyPressed(KEY_TWO)) currentLevel = 2;
         if (IsKeyPressed(KEY_THREE)) currentLevel = 3;
         
         // Shader toggles T-P
         if (IsKeyPressed(KEY_T)) waterEnabled = !waterEnabled;
-        if (IsKeyPressed(KEY_Y)) moebiusEnabled = !moebiusEnabled;
-        if (IsKeyPressed(KEY_U)) shader3 = !shader3;
-        if (IsKeyPressed(KEY_I)) shader4 = !shader4;
-        if (IsKeyPressed(KEY_O)) shader5 = !shader5;
-        if (IsKeyPressed(KEY_P)) shader6 = !shader6;
-        
-        // Hot reload
-        if (IsKeyPressed(KEY_R)) {
-            UnloadShader(waterShader);
-            UnloadShader(moebiusShader);
-            waterShader = LoadShader("resources/shaders/water.vs", "resources/shaders/water.fs");
-            moebiusShader = LoadShader("resources/shaders/moebius.vs", "resources/shaders/moebius.fs");
-            water1.materials[0].shader = waterShader;
-            water2.materials[0].shader = waterShader;
-            water3.materials[0].shader = waterShader;
-            waterTimeLoc = GetShaderLocation(waterShader, "time");
-            waterViewPosLoc = GetShaderLocation(waterShader, "viewPos");
-            moebiusResLoc = GetShaderLocation(moebiusShader, "resolution");
-            moebiusTimeLoc = GetShaderLocation(moebiusShader, "time");
+        for (int i = 0; i < (int)post.passes.size(); i++) {
+            if (IsKeyPressed(postKeys[i])) post.passes[i].enabled = !post.passes[i].enabled;
         }
+        bool reloadShaders = IsKeyPressed(KEY_R);
         
-        // --- NOCLIP MOVEMENT ---
+        SceneInput input = {};
         if (!showMenu) {
-            Vector2 mouse = GetMouseDelta();
-            yaw += mouse.x * mouseSens;
-            pitch -= mouse.y * mouseSens;
-            if (pitch > 89.0f) pitch = 89.0f;
-            if (pitch < -89.0f) pitch = -89.0f;
-            
-            Vector3 forward = {
-                cosf(DEG2RAD * yaw) * cosf(DEG2RAD * pitch),
-                sinf(DEG2RAD * pitch),
-                sinf(DEG2RAD * yaw) * cosf(DEG2RAD * pitch)
-            };
-            forward = Vector3Normalize(forward);
-            Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, {0, 1, 0}));
-            Vector3 up = { 0, 1, 0 };
-            
-            Vector3 move = { 0, 0, 0 };
-            if (IsKeyDown(KEY_W)) move = Vector3Add(move, forward);
-            if (IsKeyDown(KEY_S)) move = Vector3Subtract(move, forward);
-            if (IsKeyDown(KEY_A)) move = Vector3Subtract(move, right);
-            if (IsKeyDown(KEY_D)) move = Vector3Add(move, right);
-            if (IsKeyDown(KEY_E)) move = Vector3Add(move, up);
-            if (IsKeyDown(KEY_Q)) move = Vector3Subtract(move, up);
-            
-            float speed = moveSpeed;
-            if (IsKeyDown(KEY_LEFT_SHIFT)) speed *= 2.5f;
-            
-            if (Vector3Length(move) > 0) {
-                move = Vector3Normalize(move);
-                position = Vector3Add(position, Vector3Scale(move, speed * dt));
-            }
-            
-            camera.position = position;
-            camera.target = Vector3Add(position, forward);
+            input.mouseDelta = GetMouseDelta();
+            input.forward = IsKeyDown(KEY_W);
+            input.back = IsKeyDown(KEY_S);
+            input.left = IsKeyDown(KEY_A);
+            input.right = IsKeyDown(KEY_D);
+            input.up = IsKeyDown(KEY_E);
+            input.down = IsKeyDown(KEY_Q);
+            input.fast = IsKeyDown(KEY_LEFT_SHIFT);
         }
+        input.frameTime = GetFrameTime();
+        input.paused = showMenu;
+        input.mouseSens = mouseSens;
+        input.moveSpeed = moveSpeed;
+        input.fov = fov;
+        input.aspect = (float)w / (float)h;
+        input.screenHeight = renderHeight;
+        input.level = currentLevel;
+        input.water = waterEnabled;
+        input.culling = cullingEnabled;
+        input.lod = lodEnabled;
+        input.occlusion = occlusionEnabled;
+        input.sorting = sortingEnabled;
         
-        camera.fovy = fov;
+        // --- SIMULATE ---
+        // Hand over this frame's input and get the frame to draw: with threading, the one
+        // simulated from the previous frame's input while the last frame was being drawn
+        Shader retiredWaterShader = { 0 };
+        SceneFrame& frame = frames[pipeline.Advance([&] {
+            simInput = input;
+            
+            // Hot reload. The water materials are read by the simulation, so they switch
+            // while it is idle; the frame drawn below may still use the old water shader,
+            // which is unloaded once it has been drawn.
+            if (reloadShaders) {
+                retiredWaterShader = waterShader;
+                waterShader = LoadShader("resources/shaders/water.vs", "resources/shaders/water.fs");
+                moebius.Reload();
+                post.Reload();
+                water1.materials[WATER_VARIANT_SHADED].shader = waterShader;
+                water2.materials[WATER_VARIANT_SHADED].shader = waterShader;
+                water3.materials[WATER_VARIANT_SHADED].shader = waterShader;
+                waterTimeLoc = GetShaderLocation(waterShader, "time");
+                waterViewPosLoc = GetShaderLocation(waterShader, "viewPos");
+            }
+        })];
+        double submitStart = GetTime();
         
         // --- UPDATE SHADERS ---
-        SetShaderValue(waterShader, waterTimeLoc, &time, SHADER_UNIFORM_FLOAT);
-        float camPos[3] = { position.x, position.y, position.z };
+        SetShaderValue(waterShader, waterTimeLoc, &frame.time, SHADER_UNIFORM_FLOAT);
+        float camPos[3] = { frame.position.x, frame.position.y, frame.position.z };
         SetShaderValue(waterShader, waterViewPosLoc, camPos, SHADER_UNIFORM_VEC3);
-        float res[2] = { (float)w, (float)h };
-        SetShaderValue(moebiusShader, moebiusResLoc, res, SHADER_UNIFORM_VEC2);
-        SetShaderValue(moebiusShader, moebiusTimeLoc, &time, SHADER_UNIFORM_FLOAT);
         
         // --- RENDER TO TEXTURE ---
+        // The frame's queue is drawn by pass, with the instanced objects between the
+        // opaque and transparent passes. The viewport covers the scaled region; the
+        // projection's aspect still comes from the full target, which has the same shape.
+        sceneTimer.Begin();
         BeginTextureMode(target);
             ClearBackground((Color){ 180, 210, 240, 255 });
+            rlViewport(0, 0, renderWidth, renderHeight);
             
-            BeginMode3D(camera);
-                if (currentLevel == 1) {
-                    DrawModel(terrain1, (Vector3){ 0, 0.5f, 0 }, 1.0f, WHITE);
-                    DrawModel(rock1a, (Vector3){ -1.5f, 1.0f, 1.0f }, 1.0f, WHITE);
-                    DrawModel(rock1b, (Vector3){ 2.0f, 1.0f, -1.5f }, 1.0f, WHITE);
-                    DrawModel(tree1, (Vector3){ 0.5f, 2.0f, 0.5f }, 1.0f, WHITE);
-                    DrawModel(foliage1, (Vector3){ 0.5f, 3.5f, 0.5f }, 1.0f, WHITE);
-                    // Draw water - shader version or plain
-                    if (waterEnabled)
-                        DrawModel(water1, (Vector3){ 0, -0.2f, 0 }, 1.0f, WHITE);
-                    else
-                        DrawModel(water1_plain, (Vector3){ 0, -0.2f, 0 }, 1.0f, WHITE);
-                } else if (currentLevel == 2) {
-                    DrawModel(terrain2, (Vector3){ 0, 0.25f, 0 }, 1.0f, WHITE);
-                    DrawModel(pillar1, (Vector3){ -2.5f, 3.0f, -2.5f }, 1.0f, WHITE);
-                    DrawModel(pillar2, (Vector3){ 2.5f, 2.75f, -2.5f }, 1.0f, WHITE);
-                    DrawModel(pillar3, (Vector3){ -2.5f, 2.5f, 2.5f }, 1.0f, WHITE);
-                    DrawModel(pillar4, (Vector3){ 2.5f, 2.25f, 2.5f }, 1.0f, WHITE);
-                    DrawModel(altar, (Vector3){ 0, 1.25f, 0 }, 1.0f, WHITE);
-                    float bob = sinf(time * 2.0f) * 0.3f;
-                    DrawModel(orb, (Vector3){ 0, 3.0f + bob, 0 }, 1.0f, WHITE);
-                    // Draw water - shader version or plain
-                    if (waterEnabled)
-                        DrawModel(water2, (Vector3){ 0, -0.3f, 0 }, 1.0f, WHITE);
-                    else
-                        DrawModel(water2_plain, (Vector3){ 0, -0.3f, 0 }, 1.0f, WHITE);
-                } else if (currentLevel == 3) {
-                    // --- STRESS TEST SCENE ---
-                    DrawModel(platform3, (Vector3){ 0, 0, 0 }, 1.0f, WHITE);
-                    
-                    // Central spinning teapot
-                    DrawModelEx(teapot, (Vector3){ 0, 3.0f, 0 }, (Vector3){ 0, 1, 0 }, time * 30.0f, (Vector3){ 2.0f, 2.0f, 2.0f }, WHITE);
-                    
-                    // Orbiting teapots
-                    for (int i = 0; i < 6; i++) {
-                        float angle = time * 0.5f + (float)i * PI / 3.0f;
-                        float dist = 6.0f;
-                        Vector3 pos = { cosf(angle) * dist, 2.5f + sinf(time * 2.0f + i) * 0.5f, sinf(angle) * dist };
-                        DrawModelEx(teapot, pos, (Vector3){ 0, 1, 0 }, -time * 45.0f, (Vector3){ 1.0f, 1.0f, 1.0f }, WHITE);
-                    }
-                    
-                    // Bouncing spheres
-                    for (int i = 0; i < NUM_SPHERES; i++) {
-                        float bounce = fabsf(sinf(time * sphereSpeed3[i] + spherePhase3[i])) * 2.0f;
-                        Vector3 pos = spherePos3[i];
-                        pos.y += bounce;
-                        DrawModel(spheres3[i], pos, 1.0f, WHITE);
-                    }
-                    
-                    // Rotating cubes
-                    for (int i = 0; i < NUM_CUBES; i++) {
-                        DrawModelEx(cubes3[i], cubePos3[i], (Vector3){ 1, 1, 0 }, time * cubeRotSpeed3[i], (Vector3){ 1, 1, 1 }, WHITE);
-                    }
-                    
-                    // Static pillars
-                    for (int i = 0; i < NUM_PILLARS3; i++) {
-                        DrawModel(pillars3[i], pillarPos3[i], 1.0f, WHITE);
-                    }
-                    
-                    // Spinning torus rings
-                    for (int i = 0; i < NUM_TORUS; i++) {
-                        Vector3 pos = torusPos3[i];
-                        pos.y += sinf(time * 1.5f + (float)i) * 1.0f;
-                        DrawModelEx(torus3[i], pos, (Vector3){ 1, 0, 0 }, time * 60.0f + i * 45.0f, (Vector3){ 1, 1, 1 }, WHITE);
-                    }
-                    
-                    // Static cones
-                    for (int i = 0; i < NUM_CONES; i++) {
-                        DrawModel(cones3[i], conePos3[i], 1.0f, WHITE);
-                    }
-                    
-                    // Water
-                    if (waterEnabled)
-                        DrawModel(water3, (Vector3){ 0, -0.5f, 0 }, 1.0f, WHITE);
-                    else
-                        DrawModel(water3_plain, (Vector3){ 0, -0.5f, 0 }, 1.0f, WHITE);
-                }
-                DrawGrid(20, 1.0f);
+            BeginMode3D(frame.camera);
+                queueDraws = frame.queue.Draw(RENDER_PASS_OPAQUE);
+                instanceDraws = instanceBatch.Draw(frame.instances);
+                queueDraws += frame.queue.Draw(RENDER_PASS_TRANSPARENT);
+                grid.Draw();
             EndMode3D();
         EndTextureMode();
+        sceneTimer.End();
+        
+        // --- POST PASSES ---
+        post.Prepare(target.texture, renderWidth, renderHeight, frame.time);
         
         // --- RENDER TO SCREEN ---
         BeginDrawing();
             ClearBackground(BLACK);
             
-            if (moebiusEnabled) BeginShaderMode(moebiusShader);
-            DrawTextureRec(target.texture, 
-                (Rectangle){ 0, 0, (float)target.texture.width, -(float)target.texture.height },
-                (Vector2){ 0, 0 }, WHITE);
-            if (moebiusEnabled) EndShaderMode();
+            // The last post step upsamples the scaled region to the screen (bilinear)
+            post.Draw((Rectangle){ 0, 0, (float)w, (float)h });
+            if (moebiusEnabled) moebius.RecordTime(post.passes[moebiusPass].ms);
             
             // --- FPS ---
             if (showFps) DrawFPS(w - 100, 10);
             
             // --- DEBUG OVERLAY (F3) ---
-            if (showDebug) {
-                int dx = w - 300, dy = 40, lh = 16;
+            // Redrawn at HUD_REFRESH_INTERVAL, or at once when a toggle changes
+            unsigned int postKey = 0;
+            for (int i = 0; i < (int)post.passes.size(); i++) {
+                if (post.passes[i].enabled) postKey |= 2u << i;
+            }
+            unsigned int debugKey = (waterEnabled ? 1u : 0u) | postKey | (post.fusion ? 32768u : 0u) |
+                                    (cullingEnabled ? 64u : 0u) | (lodEnabled ? 128u : 0u) |
+                                    (occlusionEnabled ? 256u : 0u) | (instanceBatch.instancing ? 512u : 0u) |
+                                    (sortingEnabled ? 1024u : 0u) | (pipeline.threaded ? 2048u : 0u) |
+                                    (dynres.enabled ? 4096u : 0u) | ((unsigned int)moebius.mode << 13);
+            if (showDebug && debugPanel.BeginRefresh(debugKey, GetTime())) {
+                int dx = 10, dy = 10, lh = 16;
                 
-                DrawRectangle(dx - 10, dy - 10, 300, 280, Fade(BLACK, 0.75f));
-                DrawRectangleLines(dx - 10, dy - 10, 300, 280, LIME);
+                DrawRectangle(0, 0, 300, 408, Fade(BLACK, 0.75f));
+                DrawRectangleLines(0, 0, 300, 408, LIME);
                 
                 DrawText("DEBUG", dx, dy, 16, LIME); dy += lh + 8;
                 
@@ -437,42 +772,68 @@ int main() {
                 DrawText(TextFormat("Avg: %.1f ms (%.0f FPS)", perf.avgMs, perf.avgFps), dx, dy, 14, GRAY); dy += lh;
                 DrawText(TextFormat("Min: %.1f ms  Max: %.1f ms", perf.minMs, perf.maxMs), dx, dy, 14, GRAY); dy += lh + 8;
                 
-                // Frame graph
+                // Frame graph background; bars are drawn live below
                 int gw = 260, gh = 40;
                 DrawRectangle(dx, dy, gw, gh, Fade(DARKGRAY, 0.5f));
-                if (!perf.history.empty()) {
-                    float bw = (float)gw / PerfStats::SIZE;
-                    for (int i = 0; i < (int)perf.history.size(); i++) {
-                        float h = (perf.history[i] / 33.33f) * gh;
-                        if (h > gh) h = gh;
-                        Color c = perf.history[i] < 16.67f ? GREEN : (perf.history[i] < 33.33f ? YELLOW : RED);
-                        DrawRectangle(dx + (int)(i * bw), dy + gh - (int)h, (int)bw + 1, (int)h, c);
-                    }
-                }
+                graphRect = { (float)dx, (float)dy, (float)gw, (float)gh };
                 dy += gh + 10;
                 
-                DrawText(TextFormat("Pos: %.1f, %.1f, %.1f", position.x, position.y, position.z), dx, dy, 14, WHITE); dy += lh;
-                DrawText(TextFormat("Yaw: %.1f  Pitch: %.1f", yaw, pitch), dx, dy, 14, GRAY); dy += lh + 8;
+                DrawText(TextFormat("Pos: %.1f, %.1f, %.1f", frame.position.x, frame.position.y, frame.position.z), dx, dy, 14, WHITE); dy += lh;
+                DrawText(TextFormat("Yaw: %.1f  Pitch: %.1f", frame.yaw, frame.pitch), dx, dy, 14, GRAY); dy += lh;
+                DrawText(TextFormat("F4 Dyn res: %s, %d%% (%dx%d), %.1f / %.0f ms%s", dynres.enabled ? "ON" : "OFF",
+                         (int)(dynres.scale * 100.0f + 0.5f), renderWidth, renderHeight, dynres.gpuMs, dynres.budgetMs,
+                         sceneTimer.ready ? "" : " CPU"), dx, dy, 14, dynres.enabled ? WHITE : ORANGE); dy += lh;
+                const char* moebiusModes[MOEBIUS_MODES] = { "REF", "PREPASS", "HALF" };
+                DrawText(TextFormat("F5 Moebius %s: %.2f / %.2f / %.2f ms", moebiusModes[moebius.mode],
+                         moebius.modeMs[MOEBIUS_REFERENCE], moebius.modeMs[MOEBIUS_PREPASS], moebius.modeMs[MOEBIUS_HALF]),
+                         dx, dy, 14, moebiusEnabled ? WHITE : DARKGRAY); dy += lh;
+                DrawText(TextFormat("F6 Culling: %s, %d drawn / %d culled", cullingEnabled ? "ON" : "OFF", frame.cull.drawn, frame.cull.culled),
+                         dx, dy, 14, cullingEnabled ? WHITE : ORANGE); dy += lh;
+                DrawText(TextFormat("F7 LOD: %s, %dk of %dk verts", lodEnabled ? "ON" : "OFF",
+                         frame.vertices / 1000, frame.fullVertices / 1000), dx, dy, 14, lodEnabled ? WHITE : ORANGE); dy += lh;
+                DrawText(TextFormat("F8 Occlusion: %s, %d hidden", occlusionEnabled ? "ON" : "OFF", frame.cull.occluded),
+                         dx, dy, 14, occlusionEnabled ? WHITE : ORANGE); dy += lh;
+                DrawText(TextFormat("F9 Instancing: %s, %d draws, %d meshes", instanceBatch.instancing ? "ON" : "OFF",
+                         instanceDraws, (int)meshCache.meshes.size()), dx, dy, 14, instanceBatch.instancing ? WHITE : ORANGE); dy += lh;
+                DrawText(TextFormat("F10 Sort: %s, %d draws, %d -> %d binds", sortingEnabled ? "ON" : "OFF", queueDraws,
+                         frame.queue.submitted.Total(), frame.queue.executed.Total()), dx, dy, 14, sortingEnabled ? WHITE : ORANGE); dy += lh;
+                DrawText(TextFormat("F11 Threads: %s, sim %.1f / submit %.1f ms", pipeline.threaded ? "ON" : "OFF",
+                         pipeline.simMs, submitMs), dx, dy, 14, pipeline.threaded ? WHITE : ORANGE); dy += lh + 8;
                 
-                DrawText("Shaders (T-P to toggle):", dx, dy, 14, YELLOW); dy += lh;
+                DrawText(TextFormat("Shaders (T-P), F2 Fuse %s: %d steps, %.2f ms", post.fusion ? "ON" : "OFF",
+                         (int)post.steps.size(), post.TotalMs()), dx, dy, 14, YELLOW); dy += lh;
                 DrawText(TextFormat("T Water: %s", waterEnabled ? "ON" : "OFF"), dx, dy, 14, waterEnabled ? GREEN : RED); dy += lh;
-                DrawText(TextFormat("Y Moebius: %s", moebiusEnabled ? "ON" : "OFF"), dx, dy, 14, moebiusEnabled ? GREEN : RED); dy += lh;
-                DrawText(TextFormat("U Slot3: %s", shader3 ? "ON" : "OFF"), dx, dy, 14, shader3 ? GREEN : DARKGRAY); dy += lh;
-                DrawText(TextFormat("I Slot4: %s", shader4 ? "ON" : "OFF"), dx, dy, 14, shader4 ? GREEN : DARKGRAY); dy += lh;
-                DrawText(TextFormat("O Slot5: %s", shader5 ? "ON" : "OFF"), dx, dy, 14, shader5 ? GREEN : DARKGRAY); dy += lh;
-                DrawText(TextFormat("P Slot6: %s", shader6 ? "ON" : "OFF"), dx, dy, 14, shader6 ? GREEN : DARKGRAY);
+                for (int i = 0; i < (int)post.passes.size(); i++) {
+                    const PostPass& pass = post.passes[i];
+                    if (pass.enabled) {
+                        DrawText(TextFormat("%c %s: ON, %.2f ms%s", postKeyNames[i], pass.name.c_str(), pass.ms,
+                                 pass.fused ? " (fused)" : ""), dx, dy, 14, GREEN);
+                    } else {
+                        DrawText(TextFormat("%c %s: OFF", postKeyNames[i], pass.name.c_str()), dx, dy, 14, DARKGRAY);
+                    }
+                    dy += lh;
+                }
+                debugPanel.EndRefresh();
+            }
+            if (showDebug) {
+                debugPanel.Draw(w - 310, 30);
+                frameGraph.Draw({ w - 310 + graphRect.x, 30 + graphRect.y, graphRect.width, graphRect.height });
             }
             
             // --- MINIMAL HUD ---
-            DrawRectangle(10, 10, 220, 50, Fade(BLACK, 0.5f));
-            DrawText(TextFormat("Level %d%s", currentLevel, currentLevel == 3 ? " (STRESS)" : ""), 20, 18, 18, WHITE);
-            DrawText("1/2/3 Level | ESC Menu | F3 Debug", 20, 40, 10, GRAY);
+            if (levelPanel.BeginRefresh((unsigned int)currentLevel, GetTime())) {
+                DrawRectangle(0, 0, 220, 50, Fade(BLACK, 0.5f));
+                DrawText(TextFormat("Level %d%s", currentLevel, currentLevel == 3 ? " (STRESS)" : ""), 10, 8, 18, WHITE);
+                DrawText("1/2/3 Level | ESC Menu | F3 Debug", 10, 30, 10, GRAY);
+                levelPanel.EndRefresh();
+            }
+            levelPanel.Draw(10, 10);
             
             // --- SETTINGS MENU ---
             if (showMenu) {
                 DrawRectangle(0, 0, w, h, Fade(BLACK, 0.7f));
                 
-                int pw = 350, ph = 400;
+                int pw = 350, ph = 530;
                 int px = (w - pw) / 2, py = (h - ph) / 2;
                 
                 DrawRectangleRounded({ (float)px, (float)py, (float)pw, (float)ph }, 0.03f, 10, Fade(DARKGRAY, 0.95f));
@@ -501,11 +862,25 @@ int main() {
                 DrawText(TextFormat("%.1f", moveSpeed), cx + cw - 30, yp, 14, WHITE);
                 yp += 18;
                 GuiSlider({ (float)cx, (float)yp, (float)cw, 18 }, NULL, NULL, &moveSpeed, 1.0f, 30.0f);
+                yp += 30;
+                
+                // Dynamic resolution: lower bound of the scale and the GPU time it aims for
+                DrawText("Min Render Scale:", cx, yp, 14, LIGHTGRAY);
+                DrawText(TextFormat("%.0f%%", dynres.minScale * 100.0f), cx + cw - 40, yp, 14, WHITE);
+                yp += 18;
+                GuiSlider({ (float)cx, (float)yp, (float)cw, 18 }, NULL, NULL, &dynres.minScale, 0.25f, 1.0f);
+                yp += 30;
+                
+                DrawText("GPU Budget (ms):", cx, yp, 14, LIGHTGRAY);
+                DrawText(TextFormat("%.1f", dynres.budgetMs), cx + cw - 40, yp, 14, WHITE);
+                yp += 18;
+                GuiSlider({ (float)cx, (float)yp, (float)cw, 18 }, NULL, NULL, &dynres.budgetMs, 4.0f, 33.3f);
                 yp += 35;
                 
                 // Toggles
                 GuiCheckBox({ (float)cx, (float)yp, 18, 18 }, "Show FPS", &showFps); yp += 25;
-                GuiCheckBox({ (float)cx, (float)yp, 18, 18 }, "Show Debug (F3)", &showDebug); yp += 35;
+                GuiCheckBox({ (float)cx, (float)yp, 18, 18 }, "Show Debug (F3)", &showDebug); yp += 25;
+                GuiCheckBox({ (float)cx, (float)yp, 18, 18 }, "Dynamic Resolution (F4)", &dynres.enabled); yp += 35;
                 
                 DrawText("Shader Toggles:", cx, yp, 14, YELLOW); yp += 20;
                 GuiCheckBox({ (float)cx, (float)yp, 18, 18 }, "T - Water", &waterEnabled); yp += 22;
@@ -520,25 +895,31 @@ int main() {
                 }
             }
             
+            submitMs = (float)((GetTime() - submitStart) * 1000.0);
         EndDrawing();
+        if (retiredWaterShader.id != 0) UnloadShader(retiredWaterShader);
     }
     
     // Cleanup
-    UnloadModel(terrain1); UnloadModel(water1); UnloadModel(water1_plain); UnloadModel(rock1a); UnloadModel(rock1b);
+    pipeline.Stop();
+    UnloadModel(terrain1); water1.Unload(); UnloadModel(rock1a); UnloadModel(rock1b);
     UnloadModel(tree1); UnloadModel(foliage1);
-    UnloadModel(terrain2); UnloadModel(water2); UnloadModel(water2_plain); UnloadModel(pillar1); UnloadModel(pillar2);
+    UnloadModel(terrain2); water2.Unload(); UnloadModel(pillar1); UnloadModel(pillar2);
     UnloadModel(pillar3); UnloadModel(pillar4); UnloadModel(orb); UnloadModel(altar);
     
     // Level 3 cleanup
-    UnloadModel(teapot); UnloadModel(water3); UnloadModel(water3_plain); UnloadModel(platform3);
-    for (int i = 0; i < NUM_SPHERES; i++) UnloadModel(spheres3[i]);
-    for (int i = 0; i < NUM_CUBES; i++) UnloadModel(cubes3[i]);
-    for (int i = 0; i < NUM_PILLARS3; i++) UnloadModel(pillars3[i]);
-    for (int i = 0; i < NUM_TORUS; i++) UnloadModel(torus3[i]);
-    for (int i = 0; i < NUM_CONES; i++) UnloadModel(cones3[i]);
-    
-    UnloadShader(waterShader); UnloadShader(moebiusShader);
+    water3.Unload(); UnloadModel(platform3);
+    instanceBatch.Unload();
+    meshCache.Unload();
+    
+    UnloadShader(waterShader);
+    post.Unload();
+    moebius.Unload();
     UnloadRenderTexture(target);
+    sceneTimer.Unload();
+    debugPanel.Unload(); levelPanel.Unload();
+    frameGraph.Unload();
+    grid.Unload();
     CloseWindow();
     
     return 0;
@@ -0,0 +1,156 @@
+// static_batch.cpp - Static collision boxes baked into a few vertex-coloured meshes
+
+#include "static_batch.h"
+#include "raymath.h"
+#include "gl_lines.h"
+#include <cfloat>
+#include <algorithm>
+
+const int BOX_FACE_VERTICES = 24;   // 4 per face, indexed
+const int BOX_FACE_INDICES = 36;
+const int BOX_EDGE_VERTICES = 24;   // 12 line segments
+
+// Append one box's faces (CCW from outside) to the chunk arrays
+static void BakeFaces(Mesh& mesh, int box, Vector3 min, Vector3 max, Color color) {
+    float lo[3] = { min.x, min.y, min.z }, hi[3] = { max.x, max.y, max.z };
+    float* vertices = mesh.vertices + box * BOX_FACE_VERTICES * 3;
+    unsigned char* colors = mesh.colors + box * BOX_FACE_VERTICES * 4;
+    unsigned short* indices = mesh.indices + box * BOX_FACE_INDICES;
+    int base = box * BOX_FACE_VERTICES;
+    
+    int v = 0;
+    for (int axis = 0; axis < 3; axis++) {
+        int a = (axis + 1) % 3, b = (axis + 2) % 3;
+        for (int side = 0; side < 2; side++) {
+            // Walk counter-clockwise around +axis; reverse the walk on the min side
+            int walk[4][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+            for (int c = 0; c < 4; c++) {
+                const int* corner = walk[side ? c : 3 - c];
+                float p[3];
+                p[axis] = side ? hi[axis] : lo[axis];
+                p[a] = corner[0] ? hi[a] : lo[a];
+                p[b] = corner[1] ? hi[b] : lo[b];
+                for (int k = 0; k < 3; k++) vertices[(v + c) * 3 + k] = p[k];
+                colors[(v + c) * 4 + 0] = color.r;
+                colors[(v + c) * 4 + 1] = color.g;
+                colors[(v + c) * 4 + 2] = color.b;
+                colors[(v + c) * 4 + 3] = color.a;
+            }
+            int order[6] = { 0, 1, 2, 0, 2, 3 };
+            for (int i : order) *indices++ = (unsigned short)(base + v + i);
+            v += 4;
+        }
+    }
+}
+
+// Append one box's 12 edges as line-list vertices
+static void BakeEdges(std::vector<LineVertex>& edges, Vector3 min, Vector3 max, Color color) {
+    float lo[3] = { min.x, min.y, min.z }, hi[3] = { max.x, max.y, max.z };
+    for (int axis = 0; axis < 3; axis++) {
+        int a = (axis + 1) % 3, b = (axis + 2) % 3;
+        for (int edge = 0; edge < 4; edge++) {
+            for (int end = 0; end < 2; end++) {
+                float p[3];
+                p[axis] = end ? hi[axis] : lo[axis];
+                p[a] = (edge & 1) ? hi[a] : lo[a];
+                p[b] = (edge & 2) ? hi[b] : lo[b];
+                edges.push_back({ { p[0], p[1], p[2] }, color });
+            }
+        }
+    }
+}
+
+void StaticBatch::Sync(const CollisionWorld& world) {
+    if (loaded && world.version == builtVersion) return;
+    Unload();
+    
+    material = LoadMaterialDefault();
+    LoadLineDrawProcs();
+    
+    // Bake in BVH leaf order so each chunk is a spatially compact group
+    boxCount = (int)world.bvh.primIndices.size();
+    std::vector<LineVertex> edges;
+    for (int first = 0; first < boxCount; first += STATIC_BATCH_CHUNK_BOXES) {
+        int count = std::min(STATIC_BATCH_CHUNK_BOXES, boxCount - first);
+        StaticBatchChunk chunk = {};
+        chunk.bounds = { { FLT_MAX, FLT_MAX, FLT_MAX }, { -FLT_MAX, -FLT_MAX, -FLT_MAX } };
+        
+        Mesh& mesh = chunk.faces;
+        mesh.vertexCount = count * BOX_FACE_VERTICES;
+        mesh.triangleCount = count * BOX_FACE_INDICES / 3;
+        mesh.vertices = (float*)MemAlloc(mesh.vertexCount * 3 * sizeof(float));
+        mesh.colors = (unsigned char*)MemAlloc(mesh.vertexCount * 4 * sizeof(unsigned char));
+        mesh.indices = (unsigned short*)MemAlloc(count * BOX_FACE_INDICES * sizeof(unsigned short));
+        
+        edges.clear();
+        edges.reserve(count * BOX_EDGE_VERTICES);
+        for (int i = 0; i < count; i++) {
+            const CollisionBox& box = world.boxes[world.bvh.primIndices[first + i]];
+            const BoundingBox& bounds = world.bvh.primBounds[first + i];
+            BakeFaces(mesh, i, bounds.min, bounds.max, box.color);
+            if (box.outline) BakeEdges(edges, bounds.min, bounds.max, box.wireColor);
+            chunk.bounds.min = Vector3Min(chunk.bounds.min, bounds.min);
+            chunk.bounds.max = Vector3Max(chunk.bounds.max, bounds.max);
+        }
+        UploadMesh(&mesh, false);
+        
+        chunk.edgeVertexCount = (int)edges.size();
+        chunk.edgeVao = LoadLineArray(edges, &chunk.edgeVbo);
+        
+        chunks.push_back(chunk);
+    }
+    
+    builtVersion = world.version;
+    loaded = true;
+    TraceLog(LOG_INFO, "StaticBatch: %d boxes baked into %d chunks", boxCount, (int)chunks.size());
+}
+
+void StaticBatch::Unload() {
+    for (StaticBatchChunk& chunk : chunks) {
+        UnloadMesh(chunk.faces);
+        UnloadLineArray(chunk.edgeVao, chunk.edgeVbo);
+    }
+    chunks.clear();
+    // The default material shares the default shader; only its map array is ours
+    if (loaded) UnloadMaterial(material);
+    material = { 0 };
+    boxCount = visibleChunks = 0;
+    loaded = false;
+}
+
+int StaticBatch::Draw(const CollisionWorld& world, const Frustum* frustum) {
+    visibleChunks = 0;
+    if (!loaded || chunks.empty()) return 0;
+    
+    int drawCalls = 0;
+    for (StaticBatchChunk& chunk : chunks) {
+        chunk.visible = !frustum || FrustumContainsBox(*frustum, chunk.bounds);
+        if (!chunk.visible) continue;
+        DrawMesh(chunk.faces, material, MatrixIdentity());
+        visibleChunks++;
+        drawCalls++;
+    }
+    
+    if (LineDrawsAvailable()) {
+        BeginLineArrays();
+        for (const StaticBatchChunk& chunk : chunks) {
+            if (!chunk.visible) continue;
+            DrawLineArray(chunk.edgeVao, 0, chunk.edgeVertexCount);
+            drawCalls++;
+        }
+        EndLineArrays();
+    } else {
+        // No GL entry point: immediate-mode edges for the visible chunks
+        for (size_t i = 0; i < chunks.size(); i++) {
+            if (!chunks[i].visible) continue;
+            int first = (int)i * STATIC_BATCH_CHUNK_BOXES;
+            int last = std::min(first + STATIC_BATCH_CHUNK_BOXES, boxCount);
+            for (int j = first; j < last; j++) {
+                const CollisionBox& box = world.boxes[world.bvh.primIndices[j]];
+                if (box.outline) DrawCubeWires(box.position, box.size.x, box.size.y, box.size.z, box.wireColor);
+            }
+        }
+        drawCalls++;
+    }
+    return drawCalls;
+}
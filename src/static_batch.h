@@ -0,0 +1,39 @@
+// static_batch.h - Static collision boxes baked into a few vertex-coloured meshes
+#pragma once
+
+#include "raylib.h"
+#include "collision.h"
+#include "frustum.h"
+#include <vector>
+
+// Boxes per chunk: 24 vertices each keeps a chunk under the 16-bit index limit
+const int STATIC_BATCH_CHUNK_BOXES = 2048;
+
+// One baked chunk: faces as a raylib Mesh, edges as a line buffer with the same layout
+struct StaticBatchChunk {
+    Mesh faces;
+    unsigned int edgeVao;
+    unsigned int edgeVbo;
+    int edgeVertexCount;
+    BoundingBox bounds;             // Union of the chunk's boxes, for frustum culling
+    bool visible;                   // Frustum result from the last Draw
+};
+
+// Alternative to BoxRenderer: boxes are merged into world-space geometry once, with their
+// colours baked into vertex colours, and drawn as one mesh plus one line draw per chunk.
+// Chunks follow BVH leaf order, so each one covers a compact region and culls well.
+struct StaticBatch {
+    std::vector<StaticBatchChunk> chunks;
+    Material material = { 0 };      // Default material; vertex colours carry the box colours
+    unsigned int builtVersion = 0;  // CollisionWorld::version baked into the chunks
+    int boxCount = 0;
+    int visibleChunks = 0;          // Chunks that passed the frustum test in the last Draw
+    bool loaded = false;
+    
+    // Rebuild the chunks if the world changed since the last bake (needs a GL context)
+    void Sync(const CollisionWorld& world);
+    void Unload();
+    
+    // Draw chunks touching the frustum (all if null). Returns the draw calls issued.
+    int Draw(const CollisionWorld& world, const Frustum* frustum = nullptr);
+};
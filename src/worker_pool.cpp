@@ -0,0 +1,75 @@
+// worker_pool.cpp - Persistent worker threads for data-parallel loops
+
+#include "worker_pool.h"
+
+void WorkerPool::Start(int workerCount) {
+    Stop();
+    if (workerCount <= 0) workerCount = (int)std::thread::hardware_concurrency();
+    if (workerCount < 1) workerCount = 1;
+    
+    // Workers start from the current generation, so rounds run before a restart aren't
+    // picked up again; no ParallelFor can run until Start returns
+    stopping = false;
+    busyWorkers = 0;
+    for (int i = 1; i < workerCount; i++) {
+        threads.emplace_back(&WorkerPool::WorkerLoop, this, i, generation);
+    }
+}
+
+void WorkerPool::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) thread.join();
+    threads.clear();
+}
+
+void WorkerPool::ParallelFor(int count, const std::function<void(int, int)>& fn) {
+    if (count <= 0) return;
+    
+    // Not worth waking anyone for a single job
+    if (threads.empty() || count == 1) {
+        for (int i = 0; i < count; i++) fn(i, 0);
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        jobCount = count;
+        nextJob.store(0);
+        busyWorkers = (int)threads.size();
+        generation++;
+    }
+    wake.notify_all();
+    
+    RunJobs(0);
+    
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return busyWorkers == 0; });
+    job = nullptr;
+}
+
+void WorkerPool::WorkerLoop(int workerIndex, unsigned int seenGeneration) {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+        }
+        
+        RunJobs(workerIndex);
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busyWorkers == 0) done.notify_one();
+    }
+}
+
+void WorkerPool::RunJobs(int workerIndex) {
+    for (int i = nextJob.fetch_add(1); i < jobCount; i = nextJob.fetch_add(1)) {
+        (*job)(i, workerIndex);
+    }
+}
@@ -0,0 +1,43 @@
+// worker_pool.h - Persistent worker threads for data-parallel loops
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads that sleep between ParallelFor calls, so per-tick work
+// doesn't pay thread creation. The calling thread takes part as worker 0.
+struct WorkerPool {
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(int, int)>* job = nullptr;
+    int jobCount = 0;
+    std::atomic<int> nextJob{0};
+    int busyWorkers = 0;
+    unsigned int generation = 0;
+    bool stopping = false;
+    
+    WorkerPool() = default;
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    ~WorkerPool() { Stop(); }
+    
+    // Spawn workerCount - 1 threads (0 = one per hardware thread)
+    void Start(int workerCount = 0);
+    void Stop();
+    
+    // Total workers including the caller; valid worker indices are 0..WorkerCount()-1
+    int WorkerCount() const { return (int)threads.size() + 1; }
+    
+    // Run fn(jobIndex, workerIndex) for every job in [0, count) and wait for all of them.
+    // Jobs are handed out dynamically, so uneven jobs still balance across workers.
+    void ParallelFor(int count, const std::function<void(int, int)>& fn);
+    
+    void WorkerLoop(int workerIndex, unsigned int seenGeneration);
+    void RunJobs(int workerIndex);
+};
@@ -0,0 +1,76 @@
+// frame_pipeline_test.cpp - FramePipeline overlaps simulation with drawing when threaded
+//
+// A 5 ms simulation and a 5 ms "draw" per frame: threaded, frames should cost about
+// max(sim, draw) and the simulation should be running during almost every draw; serial,
+// they cost the sum and never overlap. Also checks each drawn slot holds the simulation
+// of the expected frame's input.
+
+#include "frame_pipeline.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+static const int FRAMES = 60;
+static const std::chrono::milliseconds WORK(5);
+
+struct Result {
+    float frameMs;          // Average per frame
+    int overlapped;         // Draws during which the simulation was running
+    int wrongInput;         // Drawn slots not simulated from the expected frame's input
+};
+
+static Result Run(bool threaded) {
+    int simInput = -1;
+    int frames[FRAME_PIPELINE_SLOTS] = { -1, -1, -1 };
+    std::atomic<bool> simulating(false);
+    
+    FramePipeline pipeline;
+    pipeline.threaded = threaded;
+    pipeline.Start([&](int slot) {
+        simulating = true;
+        std::this_thread::sleep_for(WORK);
+        frames[slot] = simInput;
+        simulating = false;
+    });
+    
+    Result result = {};
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) {
+        int slot = pipeline.Advance([&] { simInput = frame; });
+        
+        // Threaded, frame N draws the simulation of frame N-1's input (frame 0 its own)
+        int expected = (threaded && frame > 0) ? frame - 1 : frame;
+        if (frames[slot] != expected) result.wrongInput++;
+        
+        // Draw: busy for WORK, noting whether the simulation ran alongside
+        bool overlapped = false;
+        auto drawEnd = std::chrono::steady_clock::now() + WORK;
+        while (std::chrono::steady_clock::now() < drawEnd) {
+            if (simulating) overlapped = true;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        if (overlapped) result.overlapped++;
+    }
+    float totalMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    pipeline.Stop();
+    
+    result.frameMs = totalMs / FRAMES;
+    return result;
+}
+
+int main() {
+    Result threaded = Run(true);
+    Result serial = Run(false);
+    printf("Threaded: %.2f ms/frame, %d/%d draws overlapped, %d wrong inputs\n",
+           threaded.frameMs, threaded.overlapped, FRAMES, threaded.wrongInput);
+    printf("Serial:   %.2f ms/frame, %d/%d draws overlapped, %d wrong inputs\n",
+           serial.frameMs, serial.overlapped, FRAMES, serial.wrongInput);
+    
+    int failures = 0;
+    if (threaded.overlapped < FRAMES - 2) { printf("FAIL: threaded simulation didn't overlap drawing\n"); failures++; }
+    if (threaded.frameMs > 8.0f) { printf("FAIL: threaded frames cost more than max(sim, draw)\n"); failures++; }
+    if (serial.overlapped != 0) { printf("FAIL: serial simulation overlapped drawing\n"); failures++; }
+    if (threaded.wrongInput + serial.wrongInput != 0) { printf("FAIL: drawn frame from the wrong input\n"); failures++; }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,49 @@
+// worker_pool_test.cpp - WorkerPool runs each job once and waits for all of them, across restarts
+//
+// Start -> ParallelFor -> Start -> ParallelFor, repeated: a restarted worker must not pick
+// up the previous round again (which left busyWorkers off, or let ParallelFor return
+// early), and ParallelFor must not return while any job is running.
+
+#include "worker_pool.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+static const int ROUNDS = 500;
+static const int JOBS = 64;
+
+int main() {
+    WorkerPool pool;
+    int failures = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        pool.Start(8);
+        
+        // Half the restarts give the new workers time to start before the next round
+        if (round % 2 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            if (pool.busyWorkers != 0) { printf("FAIL: restart %d ran a stale round\n", round); return 1; }
+        }
+        for (int pass = 0; pass < 2; pass++) {
+            std::vector<std::atomic<int>> runs(JOBS);
+            std::atomic<int> running(0);
+            pool.ParallelFor(JOBS, [&](int job, int) {
+                running++;
+                std::this_thread::sleep_for(std::chrono::microseconds(20));
+                runs[job]++;
+                running--;
+            });
+            
+            // Anything still running here would be calling into a destroyed lambda
+            if (running != 0) { printf("FAIL: round %d returned with %d jobs running\n", round, running.load()); failures++; }
+            for (int job = 0; job < JOBS; job++) {
+                if (runs[job] != 1) { printf("FAIL: round %d job %d ran %d times\n", round, job, runs[job].load()); failures++; }
+            }
+            if (failures > 0) return 1;
+        }
+    }
+    printf("WorkerPool: %d restarts x 2 rounds of %d jobs on %d workers\n", ROUNDS, JOBS, pool.WorkerCount());
+    pool.Stop();
+    return 0;
+}